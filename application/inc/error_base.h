@@ -16,6 +16,7 @@
 #include "rcc.h"
 #include "rtc.h"
 #include "tim.h"
+#include "delay_arbiter.h"
 // Utils.
 #include "error.h"
 #include "maths.h"
@@ -47,6 +48,7 @@ typedef enum {
     SUCCESS = 0,
     ERROR_DL_OP_CODE,
     ERROR_SIGFOX_EP_DL_WEATHER_DATA_PERIOD,
+    ERROR_SIGFOX_EP_DL_SENSORS_PRECISION,
     // Peripherals.
     ERROR_BASE_AES = ERROR_BASE_STEP,
     ERROR_BASE_IWDG = (ERROR_BASE_AES + AES_ERROR_BASE_LAST),
@@ -78,8 +80,10 @@ typedef enum {
     ERROR_BASE_RFE = (ERROR_BASE_POWER + POWER_ERROR_BASE_LAST),
     ERROR_BASE_SIGFOX_EP_LIB = (ERROR_BASE_RFE + RFE_ERROR_BASE_LAST),
     ERROR_BASE_SIGFOX_EP_ADDON_RFP = (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_LAST * ERROR_BASE_STEP)),
+    // Peripherals arbitration.
+    ERROR_BASE_DELAY_ARBITER = (ERROR_BASE_SIGFOX_EP_ADDON_RFP + ERROR_BASE_STEP),
     // Last base value.
-    ERROR_BASE_LAST = (ERROR_BASE_SIGFOX_EP_ADDON_RFP + ERROR_BASE_STEP)
+    ERROR_BASE_LAST = (ERROR_BASE_DELAY_ARBITER + DELAY_ARBITER_ERROR_BASE_LAST)
 } ERROR_base_t;
 
 #endif /* __ERROR_BASE_H__ */
@@ -13,6 +13,10 @@
 //#define SPSWS_MODE_CLI
 //#define SPSWS_MODE_DEBUG
 
+#if ((defined SPSWS_MODE_CLI) && !(defined SPSWS_AT_BAUD_RATE))
+#define SPSWS_AT_BAUD_RATE                  9600
+#endif
+
 /*** Board options ***/
 
 #define SPSWS_WIND_RAINFALL_MEASUREMENTS
@@ -23,4 +27,9 @@
 //#define SPSWS_SEN15901_EMULATOR
 #endif
 
+//#define SPSWS_I2C_FAST_MODE
+
+// Note: the profiling frame is sent on each monitoring period (24 more uplinks per day).
+//#define SPSWS_PROFILING
+
 #endif /* __SPSWS_FLAGS_H__ */
@@ -25,10 +25,13 @@
 #include "types.h"
 // Components.
 #include "dps310.h"
+#include "dps310_hw_ext.h"
 #include "sen15901.h"
 #include "sen15901_hw.h"
+#include "sen15901_hw_ext.h"
 #include "sensors_hw.h"
 #include "sht3x.h"
+#include "sht3x_hw_ext.h"
 #include "si1133.h"
 #include "sigfox_types.h"
 #include "ultimeter.h"
@@ -63,15 +66,93 @@
 // Measurements buffers length.
 #define SPSWS_MEASUREMENT_PERIOD_SECONDS                        60
 #define SPSWS_MEASUREMENT_BUFFER_SIZE                           (3600 / SPSWS_MEASUREMENT_PERIOD_SECONDS)
+// Sensors precision policy.
+#define SPSWS_LOW_PRECISION_DECIMATION                          5
+#define SPSWS_SENSORS_PRECISION_NVM_DEFAULT                     0
+// Sensors presence back-off (maximum skip is 2^exponent - 1 measurement periods).
+#define SPSWS_SENSOR_BACKOFF_EXPONENT_MAX                       6
+#define SPSWS_SENSOR_FAILURE_COUNT_MAX                          0x0F
+#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
+// Monitoring event thresholds.
+#define SPSWS_WIND_DIRECTION_CONFIDENCE_THRESHOLD_PERCENT       50
+#endif
 #ifdef SPSWS_SEN15901_EMULATOR
 #define SPSWS_SEN15901_EMULATOR_SYNCHRO_GPIO                    GPIO_DIO4
 #endif
+#ifdef SPSWS_I2C_FAST_MODE
+#define SPSWS_I2C_PROBE_BUFFER_SIZE                             3
+#endif
+#ifdef SPSWS_PROFILING
+#define SPSWS_PROFILING_SECONDS_MAX                             0xFFF
+#define SPSWS_PROFILING_MAX_SECONDS_MAX                         0xFF
+#define SPSWS_PROFILING_WAKE_UP_COUNT_LOG2_MAX                  0x0F
+#define SPSWS_PROFILING_WAKE_UP_COUNT_MAX                       0xFFFF
+#endif
+// Error records.
+#define SPSWS_ERROR_RECORD_SIZE                                 16
+#define SPSWS_ERROR_RECORD_COUNT_MAX                            0xFFFF
+// Crash record.
+#define SPSWS_CRASH_RECORD_MAGIC                                0x53435244
+#define SPSWS_CRASH_RECORD_ERRORS_SIZE                          4
+#define SPSWS_CRASH_RECORD_FLASH_ORIGIN                         0x08000000
+#define SPSWS_CRASH_RECORD_PC_OFFSET_MAX                        0x7FFFF
+#define SPSWS_CRASH_RECORD_UPTIME_HOURS_MAX                     0xFF
+// Stack monitoring.
+#define SPSWS_STACK_PAINT_PATTERN                               0xC5C5C5C5
+#define SPSWS_STACK_PAINT_MARGIN_BYTES                          64
+#define SPSWS_STACK_FREE_UNIT_BYTES                             256
+#define SPSWS_STACK_FREE_MAX                                    0x0F
+#define SPSWS_STACK_FREE_THRESHOLD_BYTES                        512
 // Sigfox oscillator accuracy.
 #define SPSWS_SIGFOX_RC1_EPSILON_SNW_HZ                         1410
 #define SPSWS_SIGFOX_RC1_EPSILON_EP_HZ                          4340
 
 /*** SPSWS structures ***/
 
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_I2C_FAST_MODE))
+/*******************************************************************/
+typedef struct {
+    uint8_t i2c_address;
+    ERROR_code_t i2c_error_base;
+    uint8_t command[SPSWS_I2C_PROBE_BUFFER_SIZE];
+    uint8_t command_size_bytes;
+    uint8_t response_size_bytes;
+} SPSWS_i2c_probe_t;
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef enum {
+    SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_SOURCE_VOLTAGE = 0,
+    SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_STORAGE_VOLTAGE,
+    SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_SUNSHINE_LIGHT,
+    SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_LAST
+} SPSWS_external_analog_channel_index_t;
+#endif
+
+/*******************************************************************/
+typedef enum {
+    SPSWS_SENSOR_SHT3X = 0,
+    SPSWS_SENSOR_DPS310,
+    SPSWS_SENSOR_SI1133,
+    SPSWS_SENSOR_LAST
+} SPSWS_sensor_t;
+
+/*******************************************************************/
+typedef enum {
+    SPSWS_I2C_DEVICE_SHT30_INTERNAL = 0,
+    SPSWS_I2C_DEVICE_SHT30_EXTERNAL,
+    SPSWS_I2C_DEVICE_DPS310,
+    SPSWS_I2C_DEVICE_SI1133,
+    SPSWS_I2C_DEVICE_LAST
+} SPSWS_i2c_device_t;
+
+/*******************************************************************/
+typedef struct {
+    uint8_t failure_count;
+    uint32_t skip_count;
+} SPSWS_i2c_device_presence_t;
+
 /*******************************************************************/
 typedef enum {
     SPSWS_STATE_STARTUP = 0,
@@ -87,6 +168,86 @@ typedef enum {
     SPSWS_STATE_LAST
 } SPSWS_state_t;
 
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef enum {
+    SPSWS_TASK_ID_MEASURE = 0,
+#ifdef SIGFOX_EP_BIDIRECTIONAL
+    SPSWS_TASK_ID_WEATHER_INTERMEDIATE,
+#endif
+    SPSWS_TASK_ID_LAST
+} SPSWS_task_id_t;
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef void (*SPSWS_task_cb_t)(void);
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef struct {
+    SPSWS_task_cb_t callback;
+    uint32_t period_seconds;
+    uint32_t deadline_seconds;
+    uint8_t active_flag;
+} SPSWS_task_t;
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef enum {
+    SPSWS_ERROR_SEVERITY_LOW = 0,
+    SPSWS_ERROR_SEVERITY_MEDIUM,
+    SPSWS_ERROR_SEVERITY_HIGH,
+    SPSWS_ERROR_SEVERITY_LAST
+} SPSWS_error_severity_t;
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef struct {
+    ERROR_code_t code;
+    SPSWS_error_severity_t severity;
+    uint16_t count;
+    uint32_t last_uptime_seconds;
+} SPSWS_error_record_t;
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+typedef struct {
+    uint32_t magic;
+    uint32_t state;
+    uint32_t uptime_seconds;
+    uint32_t hard_fault_flag;
+    uint32_t fault_pc;
+    uint32_t fault_lr;
+    uint32_t fault_sp;
+    uint32_t stack_free_bytes;
+    ERROR_code_t last_errors[SPSWS_CRASH_RECORD_ERRORS_SIZE];
+    uint32_t last_error_index;
+    uint32_t checksum;
+} SPSWS_crash_record_t;
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+typedef enum {
+    SPSWS_WAKE_UP_SOURCE_RTC = 0,
+    SPSWS_WAKE_UP_SOURCE_EXTI,
+    SPSWS_WAKE_UP_SOURCE_LAST
+} SPSWS_wake_up_source_t;
+
+/*******************************************************************/
+typedef struct {
+    uint32_t count;
+    uint32_t total_seconds;
+    uint32_t max_seconds;
+    uint32_t wake_up_count[SPSWS_WAKE_UP_SOURCE_LAST];
+} SPSWS_state_statistics_t;
+#endif
+
 /*******************************************************************/
 typedef union {
     uint8_t all;
@@ -102,6 +263,18 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SPSWS_status_t;
 
+/*******************************************************************/
+typedef union {
+    uint8_t all;
+    struct {
+        unsigned sht30_internal_absent :1;
+        unsigned sht30_external_absent :1;
+        unsigned dps310_absent :1;
+        unsigned si1133_absent :1;
+        unsigned failure_count :4;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} SPSWS_sensors_status_t;
+
 /*******************************************************************/
 typedef union {
     uint16_t all;
@@ -121,7 +294,6 @@ typedef union {
         unsigned measure_request :1;
         unsigned valid_wakeup :1;
         unsigned sharp_hour_alarm :1;
-        unsigned first_sharp_hour_alarm :1;
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SPSWS_flags_t;
 
@@ -161,23 +333,52 @@ typedef struct {
     // State machine.
     SPSWS_state_t state;
     SPSWS_status_t status;
+    SPSWS_sensors_status_t sensors_status;
     volatile SPSWS_flags_t flags;
+#ifndef SPSWS_MODE_CLI
+    // Scheduler.
+    SPSWS_task_t tasks[SPSWS_TASK_ID_LAST];
+#endif
     // Intermediate measurements.
-    uint32_t measurements_last_time_seconds;
+    uint32_t measurements_count;
     SPSWS_measurements_t measurements;
+    SENSORS_HW_precision_t sensors_required_precision[SPSWS_SENSOR_LAST];
+    SENSORS_HW_precision_t sensors_precision[SPSWS_SENSOR_LAST];
+    SPSWS_i2c_device_presence_t i2c_devices_presence[SPSWS_I2C_DEVICE_LAST];
+#ifndef SPSWS_MODE_CLI
+    // Error records.
+    SPSWS_error_record_t error_records[SPSWS_ERROR_RECORD_SIZE];
+    uint8_t error_records_count;
+    // Crash record of the previous execution.
+    SPSWS_crash_record_t last_crash_record;
+    uint8_t last_crash_record_valid;
+    // Minimum free stack since boot.
+    uint32_t stack_free_bytes;
+#endif
 #ifdef SIGFOX_EP_BIDIRECTIONAL
     // Weather data.
     volatile uint32_t sharp_hour_uptime;
     uint8_t weather_data_period;
     uint32_t weather_message_count;
-    uint32_t weather_last_time_seconds;
 #endif
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
     SENSORS_HW_wind_tick_second_irq_cb_t wind_tick_second_callback;
+#endif
+#ifndef SPSWS_MODE_CLI
+    // Sigfox session.
+    uint8_t sigfox_ep_session_flag;
+    uint8_t sigfox_ep_session_power_flag;
 #endif
     // Sigfox frames.
     SPSWS_EP_ul_payload_weather_t sigfox_ep_ul_payload_weather;
     SIGFOX_EP_ul_payload_monitoring_t sigfox_ep_ul_payload_monitoring;
+    SIGFOX_EP_ul_payload_monitoring_event_t sigfox_ep_ul_payload_monitoring_event;
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+    // Profiling.
+    SPSWS_state_statistics_t state_statistics[SPSWS_STATE_LAST];
+    uint32_t filtered_wake_up_count;
+    SIGFOX_EP_ul_payload_profiling_t sigfox_ep_ul_payload_profiling;
+#endif
 } SPSWS_context_t;
 
 /*** SPSWS global variables ***/
@@ -185,18 +386,78 @@ typedef struct {
 #if (!(defined SPSWS_MODE_CLI) && (defined SIGFOX_EP_BIDIRECTIONAL))
 static uint32_t SPSWS_WEATHER_DATA_PERIOD_SECONDS[SIGFOX_EP_DL_WEATHER_DATA_PERIOD_LAST] = { 3600, 1800, 1200, 900, 720, 600 };
 #endif
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_I2C_FAST_MODE))
+static const SPSWS_i2c_probe_t SPSWS_I2C_PROBE_LIST[] = {
+    { I2C_ADDRESS_SHT30_INTERNAL, (ERROR_BASE_SHT30_INTERNAL + SHT3X_ERROR_BASE_I2C), { 0xF3, 0x2D, 0x00 }, 2, 3 },
+#ifdef HW2_0
+    { I2C_ADDRESS_SHT30_EXTERNAL, (ERROR_BASE_SHT30_EXTERNAL + SHT3X_ERROR_BASE_I2C), { 0xF3, 0x2D, 0x00 }, 2, 3 },
+#endif
+    { I2C_ADDRESS_DPS310, (ERROR_BASE_DPS310 + DPS310_ERROR_BASE_I2C), { 0x0D, 0x00, 0x00 }, 1, 1 },
+    { I2C_ADDRESS_SI1133, (ERROR_BASE_SI1133 + SI1133_ERROR_BASE_I2C), { 0x00, 0x00, 0x00 }, 1, 1 }
+};
+#endif
 #ifndef SPSWS_MODE_CLI
+// Default precision required by each sensor channel when energy is not limited.
+static const SENSORS_HW_precision_t SPSWS_SENSORS_REQUIRED_PRECISION_DEFAULT[SPSWS_SENSOR_LAST] = {
+    SENSORS_HW_PRECISION_HIGH,
+    SENSORS_HW_PRECISION_HIGH,
+    SENSORS_HW_PRECISION_MEDIUM
+};
 static SPSWS_context_t spsws_ctx;
+// Note: the crash record is placed outside of the .bss section so that it is not cleared by the startup code after a warm reset.
+// The linker script is expected to map the .noinit input section in RAM as a NOLOAD output section, outside of the .data and .bss ranges:
+//   .noinit (NOLOAD) : { . = ALIGN(4); *(.noinit) *(.noinit*) . = ALIGN(4); } >RAM
+// Otherwise the section is placed as an orphan after .bss, which is still valid since the stack painting starts after the record.
+// If the record ever ends up in .bss, it is cleared at each reset and the checksum check simply discards it.
+static SPSWS_crash_record_t spsws_crash_record __attribute__((section(".noinit")));
+// Linker script symbols.
+extern uint32_t _ebss;
+extern uint32_t _estack;
+static ANALOG_channel_t SPSWS_EXTERNAL_ANALOG_CHANNELS[SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_LAST] = {
+    ANALOG_CHANNEL_SOURCE_VOLTAGE_MV,
+    ANALOG_CHANNEL_STORAGE_VOLTAGE_MV,
+    ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT
+};
 #endif
 
 /*** SPSWS local functions ***/
 
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_I2C_FAST_MODE))
+/*******************************************************************/
+static void _SPSWS_probe_i2c_devices(void) {
+    // Local variables.
+    ERROR_code_t sensors_hw_status = SUCCESS;
+    uint8_t command[SPSWS_I2C_PROBE_BUFFER_SIZE];
+    uint8_t response[SPSWS_I2C_PROBE_BUFFER_SIZE];
+    uint8_t idx = 0;
+    // Turn sensors on.
+    POWER_enable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_SLEEP);
+    // Devices loop.
+    for (idx = 0; idx < (sizeof(SPSWS_I2C_PROBE_LIST) / sizeof(SPSWS_i2c_probe_t)); idx++) {
+        // Copy command.
+        command[0] = SPSWS_I2C_PROBE_LIST[idx].command[0];
+        command[1] = SPSWS_I2C_PROBE_LIST[idx].command[1];
+        command[2] = SPSWS_I2C_PROBE_LIST[idx].command[2];
+        // Identification command and response.
+        // Note: devices which do not support fast mode (typically because of long cables) are recorded in the error stack.
+        // The bus speed is a compile-time setting of the I2C driver, so such boards must be built without SPSWS_I2C_FAST_MODE.
+        sensors_hw_status = SENSORS_HW_i2c_write(SPSWS_I2C_PROBE_LIST[idx].i2c_error_base, SPSWS_I2C_PROBE_LIST[idx].i2c_address, command, SPSWS_I2C_PROBE_LIST[idx].command_size_bytes, 1);
+        if (sensors_hw_status == SUCCESS) {
+            sensors_hw_status = SENSORS_HW_i2c_read(SPSWS_I2C_PROBE_LIST[idx].i2c_error_base, SPSWS_I2C_PROBE_LIST[idx].i2c_address, response, SPSWS_I2C_PROBE_LIST[idx].response_size_bytes);
+        }
+        if (sensors_hw_status != SUCCESS) {
+            ERROR_stack_add(sensors_hw_status);
+        }
+    }
+    POWER_disable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_SENSORS);
+}
+#endif
+
 #ifndef SPSWS_MODE_CLI
 /*******************************************************************/
 static void _SPSWS_sharp_hour_alarm_callback(void) {
 #ifdef SIGFOX_EP_BIDIRECTIONAL
     // Synchronize weather period.
-    spsws_ctx.flags.first_sharp_hour_alarm = 1;
     spsws_ctx.flags.sharp_hour_alarm = 1;
     spsws_ctx.sharp_hour_uptime = RTC_get_uptime_seconds();
 #else
@@ -269,6 +530,52 @@ static void _SPSWS_store_weather_data_period(uint8_t weather_data_period) {
 }
 #endif
 
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_load_sensors_precision(void) {
+    // Local variables.
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t nvm_precision = 0;
+    uint8_t idx = 0;
+    // Sensors loop.
+    for (idx = 0; idx < SPSWS_SENSOR_LAST; idx++) {
+        // Use default precision.
+        spsws_ctx.sensors_required_precision[idx] = SPSWS_SENSORS_REQUIRED_PRECISION_DEFAULT[idx];
+        // Read configured precision (0 is the erased value and selects the default precision).
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SENSORS_PRECISION + idx), &nvm_precision);
+        NVM_stack_error(ERROR_BASE_NVM);
+        if ((nvm_status == NVM_SUCCESS) && (nvm_precision != SPSWS_SENSORS_PRECISION_NVM_DEFAULT) && (nvm_precision <= SENSORS_HW_PRECISION_LAST)) {
+            spsws_ctx.sensors_required_precision[idx] = (SENSORS_HW_precision_t) (nvm_precision - 1);
+        }
+    }
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SIGFOX_EP_BIDIRECTIONAL))
+/*******************************************************************/
+static void _SPSWS_store_sensors_precision(uint8_t* nvm_precision) {
+    // Local variables.
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t idx = 0;
+    // Check values.
+    for (idx = 0; idx < SPSWS_SENSOR_LAST; idx++) {
+        if (nvm_precision[idx] > SENSORS_HW_PRECISION_LAST) {
+            ERROR_stack_add(ERROR_SIGFOX_EP_DL_SENSORS_PRECISION);
+            goto errors;
+        }
+    }
+    // Write new values in NVM.
+    for (idx = 0; idx < SPSWS_SENSOR_LAST; idx++) {
+        nvm_status = NVM_write_byte((NVM_ADDRESS_SENSORS_PRECISION + idx), nvm_precision[idx]);
+        NVM_stack_error(ERROR_BASE_NVM);
+    }
+    // Update context.
+    _SPSWS_load_sensors_precision();
+errors:
+    return;
+}
+#endif
+
 #ifndef SPSWS_MODE_CLI
 /*******************************************************************/
 static void _SPSWS_measurement_add_sample(SPSWS_measurement_t* measurement, int32_t sample) {
@@ -286,6 +593,81 @@ static void _SPSWS_measurement_add_sample(SPSWS_measurement_t* measurement, int3
 }
 #endif
 
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_update_sensors_precision(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Sensors loop.
+    for (idx = 0; idx < SPSWS_SENSOR_LAST; idx++) {
+        // Low energy: use fastest conversions.
+        if (spsws_ctx.flags.weather_request_enabled == 0) {
+            spsws_ctx.sensors_precision[idx] = SENSORS_HW_PRECISION_LOW;
+        }
+        // First sample of the weather period: use required precision.
+        else if (spsws_ctx.measurements_count == 0) {
+            spsws_ctx.sensors_precision[idx] = spsws_ctx.sensors_required_precision[idx];
+        }
+        // Intermediate samples: limit to medium precision.
+        else {
+            spsws_ctx.sensors_precision[idx] = (spsws_ctx.sensors_required_precision[idx] < SENSORS_HW_PRECISION_MEDIUM) ? spsws_ctx.sensors_required_precision[idx] : SENSORS_HW_PRECISION_MEDIUM;
+        }
+    }
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint8_t _SPSWS_sensor_is_sampled(SPSWS_sensor_t sensor) {
+    // Note: sensors without precision setting (SI1133) are decimated in low precision mode.
+    return (((spsws_ctx.sensors_precision[sensor]) != SENSORS_HW_PRECISION_LOW) || ((spsws_ctx.measurements_count % SPSWS_LOW_PRECISION_DECIMATION) == 0));
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint8_t _SPSWS_i2c_device_is_present(SPSWS_i2c_device_t device) {
+    // Local variables.
+    SPSWS_i2c_device_presence_t* presence = &(spsws_ctx.i2c_devices_presence[device]);
+    // Skip device while back-off is running.
+    if ((presence->skip_count) > 0) {
+        (presence->skip_count)--;
+        return 0;
+    }
+    return 1;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint8_t _SPSWS_update_i2c_device_presence(SPSWS_i2c_device_t device, uint8_t success_flag) {
+    // Local variables.
+    SPSWS_i2c_device_presence_t* presence = &(spsws_ctx.i2c_devices_presence[device]);
+    uint8_t exponent = 0;
+    uint8_t report_flag = 0;
+    // Check access status.
+    if (success_flag != 0) {
+        presence->failure_count = 0;
+        presence->skip_count = 0;
+    }
+    else {
+        // Only report first failure in the error stack.
+        report_flag = ((presence->failure_count) == 0) ? 1 : 0;
+        if ((presence->failure_count) < SPSWS_SENSOR_FAILURE_COUNT_MAX) {
+            (presence->failure_count)++;
+        }
+        // Exponential back-off.
+        exponent = ((presence->failure_count) < SPSWS_SENSOR_BACKOFF_EXPONENT_MAX) ? (presence->failure_count) : SPSWS_SENSOR_BACKOFF_EXPONENT_MAX;
+        presence->skip_count = ((0b1 << exponent) - 1);
+        // Update monitoring status.
+        if (spsws_ctx.sensors_status.failure_count < SPSWS_SENSOR_FAILURE_COUNT_MAX) {
+            spsws_ctx.sensors_status.failure_count++;
+        }
+    }
+    return report_flag;
+}
+#endif
+
 #ifndef SPSWS_MODE_CLI
 /*******************************************************************/
 static void _SPSWS_reset_measurements(void) {
@@ -300,6 +682,7 @@ static void _SPSWS_reset_measurements(void) {
     spsws_ctx.measurements.sunshine_uv_index.full_flag = 0;
     spsws_ctx.measurements.pressure_atmospheric_absolute_pa.sample_count = 0;
     spsws_ctx.measurements.pressure_atmospheric_absolute_pa.full_flag = 0;
+    spsws_ctx.measurements_count = 0;
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
 #ifdef SPSWS_WIND_VANE_ULTIMETER
     ULTIMETER_reset_measurements();
@@ -539,6 +922,81 @@ static void _SPSWS_compute_final_measurements(void) {
 }
 #endif
 
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && !(defined SPSWS_MODE_CLI))
+/*******************************************************************/
+static uint16_t _SPSWS_convert_rainfall_intensity(uint32_t intensity_um_per_hour) {
+    // Local variables.
+    uint32_t intensity_tenth_mm_per_hour = (intensity_um_per_hour / 100);
+    // Clamp value.
+    if (intensity_tenth_mm_per_hour >= SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY) {
+        intensity_tenth_mm_per_hour = (SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY - 1);
+    }
+    return ((uint16_t) intensity_tenth_mm_per_hour);
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint8_t _SPSWS_compute_monitoring_event(void) {
+    // Local variables.
+    uint8_t event_flag = 0;
+    uint32_t stack_free_units = 0;
+#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
+    uint32_t tip_count = 0;
+    uint32_t generic_u32 = 0;
+#ifndef SPSWS_WIND_VANE_ULTIMETER
+    uint8_t generic_u8 = 0;
+#endif
+#endif
+    // Sensors status.
+    spsws_ctx.sensors_status.sht30_internal_absent = (spsws_ctx.i2c_devices_presence[SPSWS_I2C_DEVICE_SHT30_INTERNAL].failure_count != 0) ? 0b1 : 0b0;
+    spsws_ctx.sensors_status.sht30_external_absent = (spsws_ctx.i2c_devices_presence[SPSWS_I2C_DEVICE_SHT30_EXTERNAL].failure_count != 0) ? 0b1 : 0b0;
+    spsws_ctx.sensors_status.dps310_absent = (spsws_ctx.i2c_devices_presence[SPSWS_I2C_DEVICE_DPS310].failure_count != 0) ? 0b1 : 0b0;
+    spsws_ctx.sensors_status.si1133_absent = (spsws_ctx.i2c_devices_presence[SPSWS_I2C_DEVICE_SI1133].failure_count != 0) ? 0b1 : 0b0;
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.sensors_status = spsws_ctx.sensors_status.all;
+    if (spsws_ctx.sensors_status.all != 0) {
+        event_flag = 1;
+    }
+    // Reset failure counter for next period.
+    spsws_ctx.sensors_status.failure_count = 0;
+    // Wind direction confidence.
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.wind_direction_confidence_percent = SIGFOX_EP_ERROR_VALUE_WIND_CONFIDENCE;
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && !(defined SPSWS_WIND_VANE_ULTIMETER))
+    SEN15901_HW_get_wind_direction_confidence(&generic_u32, &generic_u8);
+    SEN15901_HW_reset_wind_direction_confidence();
+    if (generic_u32 > 0) {
+        spsws_ctx.sigfox_ep_ul_payload_monitoring_event.wind_direction_confidence_percent = generic_u8;
+        if (generic_u8 < SPSWS_WIND_DIRECTION_CONFIDENCE_THRESHOLD_PERCENT) {
+            event_flag = 1;
+        }
+    }
+#endif
+    // Rainfall peak intensities.
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_1_minute_tenth_mm_per_hour = SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY;
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_5_minutes_tenth_mm_per_hour = SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY;
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_10_minutes_tenth_mm_per_hour = SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY;
+#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
+    SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_RAINFALL_WINDOW_1_MINUTE, &tip_count, &generic_u32);
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_1_minute_tenth_mm_per_hour = _SPSWS_convert_rainfall_intensity(generic_u32);
+    SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_RAINFALL_WINDOW_5_MINUTES, &tip_count, &generic_u32);
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_5_minutes_tenth_mm_per_hour = _SPSWS_convert_rainfall_intensity(generic_u32);
+    SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_RAINFALL_WINDOW_10_MINUTES, &tip_count, &generic_u32);
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.rainfall_peak_10_minutes_tenth_mm_per_hour = _SPSWS_convert_rainfall_intensity(generic_u32);
+    SEN15901_HW_reset_rainfall_log();
+    if (tip_count > 0) {
+        event_flag = 1;
+    }
+#endif
+    // Stack margin.
+    stack_free_units = (spsws_ctx.stack_free_bytes / SPSWS_STACK_FREE_UNIT_BYTES);
+    spsws_ctx.sigfox_ep_ul_payload_monitoring_event.stack_free = (stack_free_units > SPSWS_STACK_FREE_MAX) ? SPSWS_STACK_FREE_MAX : stack_free_units;
+    if (spsws_ctx.stack_free_bytes < SPSWS_STACK_FREE_THRESHOLD_BYTES) {
+        event_flag = 1;
+    }
+    return event_flag;
+}
+#endif
+
 /*******************************************************************/
 static void _SPSWS_set_clock(uint8_t device_state) {
     // Local variables.
@@ -762,6 +1220,73 @@ static void _SPSWS_set_date_time(RTC_time_t* rtc_time) {
 }
 #endif
 
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_set_sigfox_session_power(uint8_t power_flag) {
+    // Check current state.
+    if (power_flag == spsws_ctx.sigfox_ep_session_power_flag) goto errors;
+    // Note: while the domains are held, the RF API requests become transparent,
+    // so the TCXO settling delay and the transceiver power up are only performed once.
+    if (power_flag != 0) {
+        POWER_enable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_RADIO_TCXO, LPTIM_DELAY_MODE_SLEEP);
+        POWER_enable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_RADIO, LPTIM_DELAY_MODE_SLEEP);
+    }
+    else {
+        POWER_disable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_RADIO);
+        POWER_disable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_RADIO_TCXO);
+    }
+    // Update flag.
+    spsws_ctx.sigfox_ep_session_power_flag = power_flag;
+errors:
+    return;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_open_sigfox_session(void) {
+    // Local variables.
+    SIGFOX_EP_API_status_t sigfox_ep_api_status = SIGFOX_EP_API_SUCCESS;
+    SIGFOX_EP_API_config_t lib_config;
+    uint8_t status = 0;
+    // Directly exit of the radio is disabled due to low supercap voltage.
+    if (spsws_ctx.flags.radio_enabled == 0) goto errors;
+    // Library configuration.
+    lib_config.rc = &SIGFOX_RC1;
+    // Reload watchdog.
+    IWDG_reload();
+    // Open library.
+    sigfox_ep_api_status = SIGFOX_EP_API_open(&lib_config);
+    SIGFOX_EP_API_check_status(0);
+    // Update flag.
+    spsws_ctx.sigfox_ep_session_flag = 1;
+errors:
+    UNUSED(status);
+    return;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_close_sigfox_session(void) {
+    // Local variables.
+    SIGFOX_EP_API_status_t sigfox_ep_api_status = SIGFOX_EP_API_SUCCESS;
+    uint8_t status = 0;
+    // Check flag.
+    if (spsws_ctx.sigfox_ep_session_flag == 0) goto errors;
+    // Update flag.
+    spsws_ctx.sigfox_ep_session_flag = 0;
+    // Release radio.
+    _SPSWS_set_sigfox_session_power(0);
+    // Close library.
+    sigfox_ep_api_status = SIGFOX_EP_API_close();
+    SIGFOX_EP_API_check_status(0);
+errors:
+    UNUSED(status);
+    return;
+}
+#endif
+
 #ifndef SPSWS_MODE_CLI
 /*******************************************************************/
 static void _SPSWS_send_sigfox_message(SIGFOX_EP_API_application_message_t* application_message) {
@@ -774,6 +1299,7 @@ static void _SPSWS_send_sigfox_message(SIGFOX_EP_API_application_message_t* appl
     SIGFOX_EP_dl_payload_t dl_payload;
     int16_t dl_rssi = 0;
     RTC_time_t rtc_time;
+    uint8_t nvm_precision[SPSWS_SENSOR_LAST];
 #endif
     // Directly exit of the radio is disabled due to low supercap voltage.
     if (spsws_ctx.flags.radio_enabled == 0) goto errors;
@@ -781,9 +1307,20 @@ static void _SPSWS_send_sigfox_message(SIGFOX_EP_API_application_message_t* appl
     lib_config.rc = &SIGFOX_RC1;
     // Reload watchdog.
     IWDG_reload();
-    // Open library.
-    sigfox_ep_api_status = SIGFOX_EP_API_open(&lib_config);
-    SIGFOX_EP_API_check_status(0);
+    // Open library if not already done by the current session.
+    if (spsws_ctx.sigfox_ep_session_flag == 0) {
+        sigfox_ep_api_status = SIGFOX_EP_API_open(&lib_config);
+        SIGFOX_EP_API_check_status(0);
+    }
+    // Keep radio powered between consecutive uplink messages of the session.
+    // Note: the domains are released before a bidirectional message, so that the radio is not held during the downlink window wait.
+    if (spsws_ctx.sigfox_ep_session_flag != 0) {
+#ifdef SIGFOX_EP_BIDIRECTIONAL
+        _SPSWS_set_sigfox_session_power(((application_message->bidirectional_flag) == SIGFOX_TRUE) ? 0 : 1);
+#else
+        _SPSWS_set_sigfox_session_power(1);
+#endif
+    }
     // Send message.
     sigfox_ep_api_status = SIGFOX_EP_API_send_application_message(application_message);
     SIGFOX_EP_API_check_status(0);
@@ -815,6 +1352,13 @@ static void _SPSWS_send_sigfox_message(SIGFOX_EP_API_application_message_t* appl
                     // Check and store new configuration.
                     _SPSWS_store_weather_data_period(dl_payload.set_weather_data_period.weather_data_period);
                     break;
+                case SIGFOX_EP_DL_OP_CODE_SET_SENSORS_PRECISION:
+                    // Update sensors precision policy.
+                    nvm_precision[SPSWS_SENSOR_SHT3X] = dl_payload.set_sensors_precision.sht3x_precision;
+                    nvm_precision[SPSWS_SENSOR_DPS310] = dl_payload.set_sensors_precision.dps310_precision;
+                    nvm_precision[SPSWS_SENSOR_SI1133] = dl_payload.set_sensors_precision.si1133_precision;
+                    _SPSWS_store_sensors_precision(nvm_precision);
+                    break;
                 case SIGFOX_EP_DL_OP_CODE_SET_DATE_TIME:
                     // Update RTC time.
                     rtc_time.year = dl_payload.set_date_time.year;
@@ -838,20 +1382,511 @@ static void _SPSWS_send_sigfox_message(SIGFOX_EP_API_application_message_t* appl
         spsws_ctx.flags.downlink_request = 0;
     }
 #endif
-    // Close library.
-    sigfox_ep_api_status = SIGFOX_EP_API_close();
-    SIGFOX_EP_API_check_status(0);
+    // Close library if not kept open by the current session.
+    if (spsws_ctx.sigfox_ep_session_flag == 0) {
+        sigfox_ep_api_status = SIGFOX_EP_API_close();
+        SIGFOX_EP_API_check_status(0);
+    }
     return;
 errors:
-    SIGFOX_EP_API_close();
+    // Close the session on the first failure, the next messages open their own.
+    if (spsws_ctx.sigfox_ep_session_flag != 0) {
+        _SPSWS_close_sigfox_session();
+    }
+    else {
+        SIGFOX_EP_API_close();
+    }
     UNUSED(status);
     return;
 }
 #endif
 
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static SPSWS_error_severity_t _SPSWS_get_error_severity(ERROR_code_t error_code) {
+    // Local variables.
+    SPSWS_error_severity_t severity = SPSWS_ERROR_SEVERITY_LOW;
+    // Errors which compromise the station operation (peripherals, power and radio).
+    if (((error_code >= ERROR_BASE_AES) && (error_code < ERROR_BASE_MATH)) ||
+        ((error_code >= ERROR_BASE_SX1232) && (error_code < ERROR_BASE_ULTIMETER)) ||
+        ((error_code >= ERROR_BASE_POWER) && (error_code < ERROR_BASE_LAST))) {
+        severity = SPSWS_ERROR_SEVERITY_HIGH;
+    }
+    // Errors which affect measurements or geolocation.
+    else if (((error_code >= ERROR_BASE_DPS310) && (error_code < ERROR_BASE_SX1232)) ||
+             ((error_code >= ERROR_BASE_ULTIMETER) && (error_code < ERROR_BASE_CLI)) ||
+             ((error_code >= ERROR_BASE_GPS) && (error_code < ERROR_BASE_POWER))) {
+        severity = SPSWS_ERROR_SEVERITY_MEDIUM;
+    }
+    return severity;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint32_t _SPSWS_compute_crash_record_checksum(SPSWS_crash_record_t* crash_record) {
+    // Local variables.
+    uint8_t* crash_record_bytes = (uint8_t*) crash_record;
+    uint32_t checksum = SPSWS_CRASH_RECORD_MAGIC;
+    uint8_t idx = 0;
+    // Rotate and xor all bytes except the checksum field itself.
+    for (idx = 0; idx < (sizeof(SPSWS_crash_record_t) - sizeof(uint32_t)); idx++) {
+        checksum = ((checksum << 1) | (checksum >> 31)) ^ crash_record_bytes[idx];
+    }
+    return checksum;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_update_crash_record(void) {
+    // Update running state and uptime.
+    spsws_crash_record.state = spsws_ctx.state;
+    spsws_crash_record.uptime_seconds = RTC_get_uptime_seconds();
+    spsws_crash_record.checksum = _SPSWS_compute_crash_record_checksum(&spsws_crash_record);
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_add_crash_record_error(ERROR_code_t error_code) {
+    // Store code in circular buffer.
+    spsws_crash_record.last_errors[spsws_crash_record.last_error_index] = error_code;
+    spsws_crash_record.last_error_index = ((spsws_crash_record.last_error_index + 1) % SPSWS_CRASH_RECORD_ERRORS_SIZE);
+    spsws_crash_record.checksum = _SPSWS_compute_crash_record_checksum(&spsws_crash_record);
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_init_crash_record(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Save record of the previous execution if RAM content has been retained.
+    spsws_ctx.last_crash_record_valid = 0;
+    if ((spsws_crash_record.magic == SPSWS_CRASH_RECORD_MAGIC) &&
+        (spsws_crash_record.checksum == _SPSWS_compute_crash_record_checksum(&spsws_crash_record)) &&
+        (spsws_crash_record.state < SPSWS_STATE_LAST) &&
+        (spsws_crash_record.last_error_index < SPSWS_CRASH_RECORD_ERRORS_SIZE)) {
+        spsws_ctx.last_crash_record = spsws_crash_record;
+        spsws_ctx.last_crash_record_valid = 1;
+    }
+    // Start new record.
+    spsws_crash_record.magic = SPSWS_CRASH_RECORD_MAGIC;
+    spsws_crash_record.state = SPSWS_STATE_STARTUP;
+    spsws_crash_record.uptime_seconds = 0;
+    spsws_crash_record.hard_fault_flag = 0;
+    spsws_crash_record.fault_pc = 0;
+    spsws_crash_record.fault_lr = 0;
+    spsws_crash_record.fault_sp = 0;
+    spsws_crash_record.stack_free_bytes = spsws_ctx.stack_free_bytes;
+    for (idx = 0; idx < SPSWS_CRASH_RECORD_ERRORS_SIZE; idx++) {
+        spsws_crash_record.last_errors[idx] = SUCCESS;
+    }
+    spsws_crash_record.last_error_index = 0;
+    spsws_crash_record.checksum = _SPSWS_compute_crash_record_checksum(&spsws_crash_record);
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_clear_crash_record(void) {
+    // Invalidate record before an intentional reset.
+    spsws_crash_record.magic = 0;
+    spsws_crash_record.checksum = 0;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_compute_crash(SIGFOX_EP_ul_payload_crash_t* sigfox_ep_ul_payload_crash) {
+    // Local variables.
+    SPSWS_crash_record_t* crash_record = &(spsws_ctx.last_crash_record);
+    uint32_t pc_offset = SPSWS_CRASH_RECORD_PC_OFFSET_MAX;
+    uint32_t uptime_hours = (crash_record->uptime_seconds / 3600);
+    uint8_t idx = 0;
+    // Faulting instruction address relative to flash origin.
+    if ((crash_record->hard_fault_flag != 0) && (crash_record->fault_pc >= SPSWS_CRASH_RECORD_FLASH_ORIGIN) && ((crash_record->fault_pc - SPSWS_CRASH_RECORD_FLASH_ORIGIN) < SPSWS_CRASH_RECORD_PC_OFFSET_MAX)) {
+        pc_offset = (crash_record->fault_pc - SPSWS_CRASH_RECORD_FLASH_ORIGIN);
+    }
+    // Build frame.
+    sigfox_ep_ul_payload_crash->state = crash_record->state;
+    sigfox_ep_ul_payload_crash->hard_fault_flag = (crash_record->hard_fault_flag == 0) ? 0b0 : 0b1;
+    sigfox_ep_ul_payload_crash->pc_offset = pc_offset;
+    sigfox_ep_ul_payload_crash->uptime_hours = (uptime_hours > SPSWS_CRASH_RECORD_UPTIME_HOURS_MAX) ? SPSWS_CRASH_RECORD_UPTIME_HOURS_MAX : uptime_hours;
+    // Restore last error codes (oldest first) so that they are reported in the next error stack frame.
+    for (idx = 0; idx < SPSWS_CRASH_RECORD_ERRORS_SIZE; idx++) {
+        if (crash_record->last_errors[(crash_record->last_error_index + idx) % SPSWS_CRASH_RECORD_ERRORS_SIZE] != SUCCESS) {
+            ERROR_stack_add(crash_record->last_errors[(crash_record->last_error_index + idx) % SPSWS_CRASH_RECORD_ERRORS_SIZE]);
+        }
+    }
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void __attribute__((used)) _SPSWS_hard_fault_handler(uint32_t* stack_frame) {
+    // Exception frame is {R0, R1, R2, R3, R12, LR, PC, xPSR}.
+    spsws_crash_record.hard_fault_flag = 1;
+    spsws_crash_record.fault_lr = stack_frame[5];
+    spsws_crash_record.fault_pc = stack_frame[6];
+    spsws_crash_record.fault_sp = (uint32_t) stack_frame;
+    spsws_crash_record.checksum = _SPSWS_compute_crash_record_checksum(&spsws_crash_record);
+    // Restart.
+    PWR_software_reset();
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+void __attribute__((naked)) HardFault_Handler(void) {
+    // Select the stack pointer which was in use when the fault occurred.
+    __asm volatile (
+        "movs r0, #4                        \n"
+        "mov r1, lr                         \n"
+        "tst r0, r1                         \n"
+        "beq 1f                             \n"
+        "mrs r0, psp                        \n"
+        "b 2f                               \n"
+        "1:                                 \n"
+        "mrs r0, msp                        \n"
+        "2:                                 \n"
+        // Use an absolute branch since the handler may be out of range of a Thumb-1 branch.
+        "ldr r1, =_SPSWS_hard_fault_handler \n"
+        "bx r1                              \n"
+        ".align 2                           \n"
+        ".ltorg                             \n"
+    );
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint32_t* _SPSWS_get_stack_limit(void) {
+    // Local variables.
+    uint32_t* stack_limit = &_ebss;
+    // Crash record may be placed after the .bss section by the linker.
+    if (((uint32_t) &spsws_crash_record) >= ((uint32_t) &_ebss)) {
+        stack_limit = (uint32_t*) (&spsws_crash_record + 1);
+    }
+    return stack_limit;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void __attribute__((noinline)) _SPSWS_paint_stack(void) {
+    // Local variables.
+    uint32_t* stack_word = _SPSWS_get_stack_limit();
+    uint32_t stack_pointer = 0;
+    // Read current stack pointer.
+    __asm volatile ("mov %0, sp" : "=r" (stack_pointer));
+    // Fill unused stack area with pattern, keeping a margin for the current frame.
+    stack_pointer -= SPSWS_STACK_PAINT_MARGIN_BYTES;
+    while (((uint32_t) stack_word) < stack_pointer) {
+        (*stack_word) = SPSWS_STACK_PAINT_PATTERN;
+        stack_word++;
+    }
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_update_stack_free(void) {
+    // Local variables.
+    uint32_t* stack_limit = _SPSWS_get_stack_limit();
+    uint32_t* stack_word = stack_limit;
+    // Note: the stack is painted once at boot, so the first overwritten word gives the high-water mark since boot.
+    while ((stack_word < &_estack) && ((*stack_word) == SPSWS_STACK_PAINT_PATTERN)) {
+        stack_word++;
+    }
+    spsws_ctx.stack_free_bytes = (((uint32_t) stack_word) - ((uint32_t) stack_limit));
+    // Update crash record.
+    spsws_crash_record.stack_free_bytes = spsws_ctx.stack_free_bytes;
+    spsws_crash_record.checksum = _SPSWS_compute_crash_record_checksum(&spsws_crash_record);
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_record_errors(void) {
+    // Local variables.
+    ERROR_code_t error_code = SUCCESS;
+    SPSWS_error_severity_t severity = SPSWS_ERROR_SEVERITY_LOW;
+    uint32_t uptime_seconds = RTC_get_uptime_seconds();
+    uint8_t record_idx = 0;
+    uint8_t idx = 0;
+    // Import Sigfox library error stack.
+    ERROR_import_sigfox_stack();
+    // Move all stacked codes to the records table.
+    while (ERROR_stack_is_empty() == 0) {
+        error_code = ERROR_stack_read();
+        severity = _SPSWS_get_error_severity(error_code);
+        _SPSWS_add_crash_record_error(error_code);
+        // Search existing record.
+        for (record_idx = 0; record_idx < spsws_ctx.error_records_count; record_idx++) {
+            if (spsws_ctx.error_records[record_idx].code == error_code) break;
+        }
+        // Create new record if needed.
+        if (record_idx >= spsws_ctx.error_records_count) {
+            if (spsws_ctx.error_records_count < SPSWS_ERROR_RECORD_SIZE) {
+                spsws_ctx.error_records_count++;
+            }
+            else {
+                // Table is full: replace the least informative record if the new code is more severe.
+                record_idx = 0;
+                for (idx = 1; idx < SPSWS_ERROR_RECORD_SIZE; idx++) {
+                    if ((spsws_ctx.error_records[idx].severity < spsws_ctx.error_records[record_idx].severity) ||
+                        ((spsws_ctx.error_records[idx].severity == spsws_ctx.error_records[record_idx].severity) && (spsws_ctx.error_records[idx].count < spsws_ctx.error_records[record_idx].count))) {
+                        record_idx = idx;
+                    }
+                }
+                if (severity <= spsws_ctx.error_records[record_idx].severity) {
+                    // Discard new code.
+                    continue;
+                }
+            }
+            spsws_ctx.error_records[record_idx].code = error_code;
+            spsws_ctx.error_records[record_idx].severity = severity;
+            spsws_ctx.error_records[record_idx].count = 0;
+        }
+        // Update record.
+        if (spsws_ctx.error_records[record_idx].count < SPSWS_ERROR_RECORD_COUNT_MAX) {
+            spsws_ctx.error_records[record_idx].count++;
+        }
+        spsws_ctx.error_records[record_idx].last_uptime_seconds = uptime_seconds;
+    }
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static uint8_t _SPSWS_read_error_records(uint8_t* error_stack_payload, uint8_t error_stack_payload_size) {
+    // Local variables.
+    SPSWS_error_record_t record;
+    uint8_t codes_count = 0;
+    uint8_t idx = 0;
+    uint8_t sort_idx = 0;
+    // Rank records by severity, then by occurrences, then by last occurrence (insertion sort).
+    for (idx = 1; idx < spsws_ctx.error_records_count; idx++) {
+        record = spsws_ctx.error_records[idx];
+        sort_idx = idx;
+        while ((sort_idx > 0) &&
+               ((record.severity > spsws_ctx.error_records[sort_idx - 1].severity) ||
+               ((record.severity == spsws_ctx.error_records[sort_idx - 1].severity) && (record.count > spsws_ctx.error_records[sort_idx - 1].count)) ||
+               ((record.severity == spsws_ctx.error_records[sort_idx - 1].severity) && (record.count == spsws_ctx.error_records[sort_idx - 1].count) && (record.last_uptime_seconds > spsws_ctx.error_records[sort_idx - 1].last_uptime_seconds)))) {
+            spsws_ctx.error_records[sort_idx] = spsws_ctx.error_records[sort_idx - 1];
+            sort_idx--;
+        }
+        spsws_ctx.error_records[sort_idx] = record;
+    }
+    // Fill payload with the most informative distinct codes.
+    for (idx = 0; idx < (error_stack_payload_size >> 1); idx++) {
+        record.code = SUCCESS;
+        if (idx < spsws_ctx.error_records_count) {
+            record.code = spsws_ctx.error_records[idx].code;
+            codes_count++;
+        }
+        error_stack_payload[(idx << 1) + 0] = (uint8_t) ((record.code >> 8) & 0x00FF);
+        error_stack_payload[(idx << 1) + 1] = (uint8_t) ((record.code >> 0) & 0x00FF);
+    }
+    // Reset records.
+    spsws_ctx.error_records_count = 0;
+    return codes_count;
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+static void _SPSWS_reset_state_statistics(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    uint8_t source_idx = 0;
+    // Reset all states.
+    for (idx = 0; idx < SPSWS_STATE_LAST; idx++) {
+        spsws_ctx.state_statistics[idx].count = 0;
+        spsws_ctx.state_statistics[idx].total_seconds = 0;
+        spsws_ctx.state_statistics[idx].max_seconds = 0;
+        for (source_idx = 0; source_idx < SPSWS_WAKE_UP_SOURCE_LAST; source_idx++) {
+            spsws_ctx.state_statistics[idx].wake_up_count[source_idx] = 0;
+        }
+    }
+    spsws_ctx.filtered_wake_up_count = 0;
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+static void _SPSWS_update_state_statistics(SPSWS_state_t state, uint32_t start_uptime_seconds) {
+    // Local variables.
+    uint32_t duration_seconds = (RTC_get_uptime_seconds() - start_uptime_seconds);
+    // Note: durations have the uptime resolution, a state shorter than one second only counts when it crosses a second boundary.
+    // Over a whole period, the number of crossed boundaries still gives the time spent in the state.
+    // Update statistics.
+    spsws_ctx.state_statistics[state].count++;
+    spsws_ctx.state_statistics[state].total_seconds += duration_seconds;
+    if (duration_seconds > spsws_ctx.state_statistics[state].max_seconds) {
+        spsws_ctx.state_statistics[state].max_seconds = duration_seconds;
+    }
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+static void _SPSWS_update_wake_up_statistics(SPSWS_state_t state, uint32_t stop_uptime_seconds) {
+    // Local variables.
+    SPSWS_wake_up_source_t source = SPSWS_WAKE_UP_SOURCE_RTC;
+    // Note: the RTC wake-up timer is the only periodic source, any other wake-up comes from an external interrupt (wind or rainfall edge).
+    if (RTC_get_uptime_seconds() == stop_uptime_seconds) {
+        source = SPSWS_WAKE_UP_SOURCE_EXTI;
+    }
+    spsws_ctx.state_statistics[state].wake_up_count[source]++;
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+static void _SPSWS_store_profiling(void) {
+    // Local variables.
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint32_t wake_up_count = 0;
+    uint8_t idx = 0;
+    // Frame.
+    for (idx = 0; idx < SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING; idx++) {
+        nvm_status = NVM_write_byte((NVM_ADDRESS_PROFILING_FRAME + idx), spsws_ctx.sigfox_ep_ul_payload_profiling.frame[idx]);
+        NVM_stack_error(ERROR_BASE_NVM);
+    }
+    // Sleep state wake-up sources.
+    for (idx = 0; idx < SPSWS_WAKE_UP_SOURCE_LAST; idx++) {
+        wake_up_count = spsws_ctx.state_statistics[SPSWS_STATE_SLEEP].wake_up_count[idx];
+        if (wake_up_count > SPSWS_PROFILING_WAKE_UP_COUNT_MAX) {
+            wake_up_count = SPSWS_PROFILING_WAKE_UP_COUNT_MAX;
+        }
+        nvm_status = NVM_write_byte((NVM_ADDRESS_PROFILING_WAKE_UP_COUNT + (idx << 1) + 0), (uint8_t) (wake_up_count >> 8));
+        NVM_stack_error(ERROR_BASE_NVM);
+        nvm_status = NVM_write_byte((NVM_ADDRESS_PROFILING_WAKE_UP_COUNT + (idx << 1) + 1), (uint8_t) (wake_up_count >> 0));
+        NVM_stack_error(ERROR_BASE_NVM);
+    }
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SPSWS_PROFILING))
+/*******************************************************************/
+static void _SPSWS_compute_profiling(void) {
+    // Local variables.
+    uint32_t awake_seconds = 0;
+    uint32_t dominant_state_seconds = 0;
+    uint32_t dominant_state_max_seconds = 0;
+    uint32_t wake_up_count = spsws_ctx.filtered_wake_up_count;
+    uint8_t wake_up_count_log2 = 0;
+    uint8_t dominant_state = SPSWS_STATE_STARTUP;
+    uint8_t idx = 0;
+    // Search the state which dominates awake time.
+    for (idx = 0; idx < SPSWS_STATE_LAST; idx++) {
+        // Sleep state is not part of awake time.
+        if (idx != SPSWS_STATE_SLEEP) {
+            awake_seconds += spsws_ctx.state_statistics[idx].total_seconds;
+            if (spsws_ctx.state_statistics[idx].total_seconds > spsws_ctx.state_statistics[dominant_state].total_seconds) {
+                dominant_state = idx;
+            }
+        }
+    }
+    // Filtered wake-ups magnitude.
+    while ((wake_up_count > 1) && (wake_up_count_log2 < SPSWS_PROFILING_WAKE_UP_COUNT_LOG2_MAX)) {
+        wake_up_count >>= 1;
+        wake_up_count_log2++;
+    }
+    dominant_state_seconds = spsws_ctx.state_statistics[dominant_state].total_seconds;
+    dominant_state_max_seconds = spsws_ctx.state_statistics[dominant_state].max_seconds;
+    // Build frame.
+    spsws_ctx.sigfox_ep_ul_payload_profiling.awake_seconds = (awake_seconds > SPSWS_PROFILING_SECONDS_MAX) ? SPSWS_PROFILING_SECONDS_MAX : awake_seconds;
+    spsws_ctx.sigfox_ep_ul_payload_profiling.dominant_state = dominant_state;
+    spsws_ctx.sigfox_ep_ul_payload_profiling.dominant_state_seconds = (dominant_state_seconds > SPSWS_PROFILING_SECONDS_MAX) ? SPSWS_PROFILING_SECONDS_MAX : dominant_state_seconds;
+    spsws_ctx.sigfox_ep_ul_payload_profiling.dominant_state_max_seconds = (dominant_state_max_seconds > SPSWS_PROFILING_MAX_SECONDS_MAX) ? SPSWS_PROFILING_MAX_SECONDS_MAX : dominant_state_max_seconds;
+    spsws_ctx.sigfox_ep_ul_payload_profiling.filtered_wake_up_count_log2 = (spsws_ctx.filtered_wake_up_count == 0) ? 0 : (wake_up_count_log2 + 1);
+    // Keep last period for CLI readout.
+    _SPSWS_store_profiling();
+    // Start new period.
+    _SPSWS_reset_state_statistics();
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_measure_task_callback(void) {
+    // Set request.
+    spsws_ctx.flags.measure_request = 1;
+}
+#endif
+
+#if (!(defined SPSWS_MODE_CLI) && (defined SIGFOX_EP_BIDIRECTIONAL))
+/*******************************************************************/
+static void _SPSWS_weather_intermediate_task_callback(void) {
+    // Note: the last slot of the hour is handled by the sharp hour alarm.
+    if (spsws_ctx.weather_message_count < (3600 / spsws_ctx.tasks[SPSWS_TASK_ID_WEATHER_INTERMEDIATE].period_seconds)) {
+        // Set request.
+        spsws_ctx.flags.weather_request = spsws_ctx.flags.weather_request_enabled;
+        spsws_ctx.flags.weather_request_intermediate = 1;
+        // Update message count.
+        spsws_ctx.weather_message_count++;
+    }
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_scheduler_start_task(SPSWS_task_id_t task_id, SPSWS_task_cb_t callback, uint32_t deadline_seconds, uint32_t period_seconds) {
+    // Note: a null period defines a one-shot task.
+    spsws_ctx.tasks[task_id].callback = callback;
+    spsws_ctx.tasks[task_id].period_seconds = period_seconds;
+    spsws_ctx.tasks[task_id].deadline_seconds = deadline_seconds;
+    spsws_ctx.tasks[task_id].active_flag = 1;
+}
+#endif
+
+#ifndef SPSWS_MODE_CLI
+/*******************************************************************/
+static void _SPSWS_scheduler_process(uint32_t uptime_seconds) {
+    // Local variables.
+    SPSWS_task_t* task = NULL;
+    uint8_t idx = 0;
+    // Note: tasks only replace the periodic request timers of the task check state.
+    // They are evaluated on each RTC wake-up, so their resolution is the uptime second.
+    // Execute expired tasks by deadline order.
+    do {
+        task = NULL;
+        for (idx = 0; idx < SPSWS_TASK_ID_LAST; idx++) {
+            if ((spsws_ctx.tasks[idx].active_flag != 0) && (spsws_ctx.tasks[idx].deadline_seconds <= uptime_seconds)) {
+                if ((task == NULL) || (spsws_ctx.tasks[idx].deadline_seconds < (task->deadline_seconds))) {
+                    task = &(spsws_ctx.tasks[idx]);
+                }
+            }
+        }
+        if (task == NULL) break;
+        // Compute next deadline before execution, so that the callback can restart its own task.
+        if ((task->period_seconds) == 0) {
+            task->active_flag = 0;
+        }
+        else {
+            task->deadline_seconds += (task->period_seconds);
+            // Skip missed periods (long blocking states).
+            if ((task->deadline_seconds) <= uptime_seconds) {
+                task->deadline_seconds = (uptime_seconds + (task->period_seconds));
+            }
+        }
+        if ((task->callback) != NULL) {
+            task->callback();
+        }
+    }
+    while (task != NULL);
+}
+#endif
+
 #ifndef SPSWS_MODE_CLI
 /*******************************************************************/
 static void _SPSWS_init_context(void) {
+    // Local variables.
+    uint8_t idx = 0;
     // Init context.
     spsws_ctx.state = SPSWS_STATE_STARTUP;
     spsws_ctx.flags.all = 0;
@@ -859,18 +1894,43 @@ static void _SPSWS_init_context(void) {
     spsws_ctx.flags.radio_enabled = 1;
     spsws_ctx.flags.weather_request_enabled = 1;
     spsws_ctx.status.all = 0;
+    spsws_ctx.sensors_status.all = 0;
+    // Sensors presence.
+    for (idx = 0; idx < SPSWS_I2C_DEVICE_LAST; idx++) {
+        spsws_ctx.i2c_devices_presence[idx].failure_count = 0;
+        spsws_ctx.i2c_devices_presence[idx].skip_count = 0;
+    }
+    // Error records.
+    spsws_ctx.error_records_count = 0;
+    // Stack monitoring.
+    spsws_ctx.stack_free_bytes = 0;
+    // Crash record.
+    _SPSWS_init_crash_record();
+    // Sigfox session.
+    spsws_ctx.sigfox_ep_session_flag = 0;
+    spsws_ctx.sigfox_ep_session_power_flag = 0;
+    // Scheduler.
+    for (idx = 0; idx < SPSWS_TASK_ID_LAST; idx++) {
+        spsws_ctx.tasks[idx].callback = NULL;
+        spsws_ctx.tasks[idx].active_flag = 0;
+    }
+    _SPSWS_scheduler_start_task(SPSWS_TASK_ID_MEASURE, &_SPSWS_measure_task_callback, SPSWS_MEASUREMENT_PERIOD_SECONDS, SPSWS_MEASUREMENT_PERIOD_SECONDS);
     // Intermediate measurements.
-    spsws_ctx.measurements_last_time_seconds = 0;
     _SPSWS_reset_measurements();
+#ifdef SPSWS_PROFILING
+    // Profiling.
+    _SPSWS_reset_state_statistics();
+#endif
 #ifdef SIGFOX_EP_BIDIRECTIONAL
     // Weather data.
     spsws_ctx.sharp_hour_uptime = 0;
-    spsws_ctx.weather_last_time_seconds = 0;
     spsws_ctx.weather_message_count = 0;
     // Load configuration from NVM.
     _SPSWS_load_weather_data_period();
     _SPSWS_store_weather_data_period(spsws_ctx.weather_data_period);
 #endif
+    // Sensors precision policy.
+    _SPSWS_load_sensors_precision();
     // Init station mode.
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
     spsws_ctx.status.station_mode = 0b1;
@@ -887,6 +1947,7 @@ static void _SPSWS_init_hw(void) {
     NVM_status_t nvm_status = NVM_SUCCESS;
     RTC_status_t rtc_status = RTC_SUCCESS;
     LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
 #ifndef SPSWS_MODE_DEBUG
     IWDG_status_t iwdg_status = IWDG_SUCCESS;
 #endif
@@ -933,6 +1994,9 @@ static void _SPSWS_init_hw(void) {
     // Read LS byte of the device ID to add a random delay in RTC alarm.
     nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_ID + SIGFOX_EP_ID_SIZE_BYTES - 1), &device_id_lsbyte);
     NVM_stack_error(ERROR_BASE_NVM);
+    // Read analog calibration.
+    analog_status = ANALOG_read_calibration();
+    ANALOG_stack_error(ERROR_BASE_ANALOG);
 #ifndef SPSWS_MODE_CLI
     // Init RTC alarm.
     rtc_alarm_config.mode = RTC_ALARM_MODE_DATE;
@@ -996,18 +2060,23 @@ int main(void) {
     GPS_acquisition_status_t gps_acquisition_status = GPS_ACQUISITION_SUCCESS;
     SIGFOX_EP_API_application_message_t application_message;
     SIGFOX_EP_ul_payload_startup_t sigfox_ep_ul_payload_startup;
+    SIGFOX_EP_ul_payload_crash_t sigfox_ep_ul_payload_crash;
     SIGFOX_EP_ul_payload_geoloc_t sigfox_ep_ul_payload_geoloc;
     SIGFOX_EP_ul_payload_geoloc_timeout_t sigfox_ep_ul_payload_geoloc_timeout;
-    ERROR_code_t error_code = 0;
     uint8_t sigfox_ep_ul_payload_error_stack[SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK];
     uint32_t generic_u32_1 = 0;
-#ifdef SIGFOX_EP_BIDIRECTIONAL
     uint32_t generic_u32_2 = 0;
-#endif
     int32_t generic_s32_1 = 0;
     int32_t generic_s32_2 = 0;
+    int32_t external_analog_data[SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_LAST];
     uint8_t por_flag = 1;
-    uint8_t idx = 0;
+#ifdef SPSWS_PROFILING
+    SPSWS_state_t profiling_state = SPSWS_STATE_STARTUP;
+    uint32_t profiling_start_uptime_seconds = 0;
+    uint32_t profiling_stop_uptime_seconds = 0;
+#endif
+    // Fill unused stack area before any deep call.
+    _SPSWS_paint_stack();
     // Init board.
     _SPSWS_init_context();
     _SPSWS_init_hw();
@@ -1024,6 +2093,12 @@ int main(void) {
     while (1) {
         // Reload watchdog.
         IWDG_reload();
+        // Keep track of the running state in case of reset.
+        _SPSWS_update_crash_record();
+#ifdef SPSWS_PROFILING
+        profiling_state = spsws_ctx.state;
+        profiling_start_uptime_seconds = RTC_get_uptime_seconds();
+#endif
         // Perform state machine.
         switch (spsws_ctx.state) {
         case SPSWS_STATE_STARTUP:
@@ -1042,6 +2117,10 @@ int main(void) {
             sigfox_ep_ul_payload_startup.dirty_flag = GIT_DIRTY_FLAG;
             // Clear reset flags.
             PWR_clear_reset_flags();
+#ifdef SPSWS_I2C_FAST_MODE
+            // Check sensors bus speed.
+            _SPSWS_probe_i2c_devices();
+#endif
             // Send startup message.
             application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_600BPS;
             application_message.ul_payload = (sfx_u8*) (sigfox_ep_ul_payload_startup.frame);
@@ -1050,7 +2129,17 @@ int main(void) {
             application_message.common_parameters.number_of_frames = 3;
             application_message.bidirectional_flag = SIGFOX_FALSE;
 #endif
+            _SPSWS_open_sigfox_session();
             _SPSWS_send_sigfox_message(&application_message);
+            // Send crash record of the previous execution.
+            if (spsws_ctx.last_crash_record_valid != 0) {
+                _SPSWS_compute_crash(&sigfox_ep_ul_payload_crash);
+                application_message.ul_payload = (sfx_u8*) (sigfox_ep_ul_payload_crash.frame);
+                application_message.ul_payload_size_bytes = SIGFOX_EP_UL_PAYLOAD_SIZE_CRASH;
+                _SPSWS_send_sigfox_message(&application_message);
+                spsws_ctx.last_crash_record_valid = 0;
+            }
+            _SPSWS_close_sigfox_session();
             // Perform first RTC calibration.
             spsws_ctx.state = SPSWS_STATE_RTC_CALIBRATION;
             break;
@@ -1059,6 +2148,8 @@ int main(void) {
             // Note: digital sensors must also be powered at this step to read the LDR.
             POWER_enable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_SLEEP);
             POWER_enable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_SLEEP);
+            // Select sensors precision according to energy state and weather period.
+            _SPSWS_update_sensors_precision();
             // MCU voltage.
             analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_MCU_VOLTAGE_MV, &generic_s32_1);
             ANALOG_stack_error(ERROR_BASE_ANALOG);
@@ -1071,16 +2162,14 @@ int main(void) {
             if (analog_status == ANALOG_SUCCESS) {
                 _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.mcu_temperature_degrees), generic_s32_1);
             }
-            // Solar cell voltage.
-            analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SOURCE_VOLTAGE_MV, &generic_s32_1);
-            ANALOG_stack_error(ERROR_BASE_ANALOG);
-            if (analog_status == ANALOG_SUCCESS) {
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.source_voltage_mv), generic_s32_1);
-            }
-            // Supercap voltage.
-            analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_STORAGE_VOLTAGE_MV, &generic_s32_1);
+            // External ADC channels.
+            analog_status = ANALOG_convert_channels(SPSWS_EXTERNAL_ANALOG_CHANNELS, SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_LAST, external_analog_data);
             ANALOG_stack_error(ERROR_BASE_ANALOG);
             if (analog_status == ANALOG_SUCCESS) {
+                // Solar cell voltage.
+                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.source_voltage_mv), external_analog_data[SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_SOURCE_VOLTAGE]);
+                // Supercap voltage.
+                generic_s32_1 = external_analog_data[SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_STORAGE_VOLTAGE];
                 _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.storage_voltage_mv), generic_s32_1);
                 // Voltage hysteresis for radio.
                 if (generic_s32_1 < SPSWS_RADIO_OFF_STORAGE_VOLTAGE_THRESHOLD_MV) {
@@ -1096,55 +2185,68 @@ int main(void) {
                 if (generic_s32_1 > SPSWS_WEATHER_REQUEST_ON_STORAGE_VOLTAGE_THRESHOLD_MV) {
                     spsws_ctx.flags.weather_request_enabled = 1;
                 }
-            }
-            // Light sensor.
-            analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT, &generic_s32_1);
-            ANALOG_stack_error(ERROR_BASE_ANALOG);
-            if (analog_status == ANALOG_SUCCESS) {
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.sunshine_light_percent), generic_s32_1);
+                // Light sensor.
+                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.sunshine_light_percent), external_analog_data[SPSWS_EXTERNAL_ANALOG_CHANNEL_INDEX_SUNSHINE_LIGHT]);
             }
             POWER_disable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_ANALOG);
             // Internal temperature/humidity sensor.
-            sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30_INTERNAL, &generic_s32_1, &generic_s32_2);
-            SHT3X_stack_error(ERROR_BASE_SHT30_INTERNAL);
-            // Check status.
-            if (sht3x_status == SHT3X_SUCCESS) {
-                // Store temperature and humidity.
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_pcb_tenth_degrees), generic_s32_1);
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_pcb_percent), generic_s32_2);
+            if (_SPSWS_i2c_device_is_present(SPSWS_I2C_DEVICE_SHT30_INTERNAL) != 0) {
+                sht3x_status = SHT3X_HW_get_temperature_humidity_precision(I2C_ADDRESS_SHT30_INTERNAL, spsws_ctx.sensors_precision[SPSWS_SENSOR_SHT3X], &generic_s32_1, &generic_s32_2);
+                if (_SPSWS_update_i2c_device_presence(SPSWS_I2C_DEVICE_SHT30_INTERNAL, (sht3x_status == SHT3X_SUCCESS)) != 0) {
+                    SHT3X_stack_error(ERROR_BASE_SHT30_INTERNAL);
+                }
+                // Check status.
+                if (sht3x_status == SHT3X_SUCCESS) {
+                    // Store temperature and humidity.
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_pcb_tenth_degrees), generic_s32_1);
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_pcb_percent), generic_s32_2);
 #ifdef HW1_0
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_ambiant_tenth_degrees), generic_s32_1);
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_ambiant_percent), generic_s32_2);
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_ambiant_tenth_degrees), generic_s32_1);
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_ambiant_percent), generic_s32_2);
 #endif
+                }
             }
 #ifdef HW2_0
             // External temperature/humidity sensor.
-            sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30_EXTERNAL, &generic_s32_1, &generic_s32_2);
-            SHT3X_stack_error(ERROR_BASE_SHT30_EXTERNAL);
-            // Check status.
-            if (sht3x_status == SHT3X_SUCCESS) {
-                // Store temperature and humidity.
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_ambiant_tenth_degrees), generic_s32_1);
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_ambiant_percent), generic_s32_2);
+            if (_SPSWS_i2c_device_is_present(SPSWS_I2C_DEVICE_SHT30_EXTERNAL) != 0) {
+                sht3x_status = SHT3X_HW_get_temperature_humidity_precision(I2C_ADDRESS_SHT30_EXTERNAL, spsws_ctx.sensors_precision[SPSWS_SENSOR_SHT3X], &generic_s32_1, &generic_s32_2);
+                if (_SPSWS_update_i2c_device_presence(SPSWS_I2C_DEVICE_SHT30_EXTERNAL, (sht3x_status == SHT3X_SUCCESS)) != 0) {
+                    SHT3X_stack_error(ERROR_BASE_SHT30_EXTERNAL);
+                }
+                // Check status.
+                if (sht3x_status == SHT3X_SUCCESS) {
+                    // Store temperature and humidity.
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.temperature_ambiant_tenth_degrees), generic_s32_1);
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.humidity_ambiant_percent), generic_s32_2);
+                }
             }
 #endif
             // External pressure and temperature sensor.
-            dps310_status = DPS310_get_pressure_temperature(I2C_ADDRESS_DPS310, &generic_s32_1, &generic_s32_2);
-            DPS310_stack_error(ERROR_BASE_DPS310);
-            // Check status.
-            if (dps310_status == DPS310_SUCCESS) {
-                // Store pressure.
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.pressure_atmospheric_absolute_pa), generic_s32_1);
+            if (_SPSWS_i2c_device_is_present(SPSWS_I2C_DEVICE_DPS310) != 0) {
+                dps310_status = DPS310_HW_get_pressure_temperature_precision(I2C_ADDRESS_DPS310, spsws_ctx.sensors_precision[SPSWS_SENSOR_DPS310], &generic_s32_1, &generic_s32_2);
+                if (_SPSWS_update_i2c_device_presence(SPSWS_I2C_DEVICE_DPS310, (dps310_status == DPS310_SUCCESS)) != 0) {
+                    DPS310_stack_error(ERROR_BASE_DPS310);
+                }
+                // Check status.
+                if (dps310_status == DPS310_SUCCESS) {
+                    // Store pressure.
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.pressure_atmospheric_absolute_pa), generic_s32_1);
+                }
             }
             // External UV index sensor.
-            si1133_status = SI1133_get_uv_index(I2C_ADDRESS_SI1133, &generic_s32_1);
-            SI1133_stack_error(ERROR_BASE_SI1133);
-            // Check status.
-            if (si1133_status == SI1133_SUCCESS) {
-                // Store UV index.
-                _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.sunshine_uv_index), generic_s32_1);
+            if ((_SPSWS_sensor_is_sampled(SPSWS_SENSOR_SI1133) != 0) && (_SPSWS_i2c_device_is_present(SPSWS_I2C_DEVICE_SI1133) != 0)) {
+                si1133_status = SI1133_get_uv_index(I2C_ADDRESS_SI1133, &generic_s32_1);
+                if (_SPSWS_update_i2c_device_presence(SPSWS_I2C_DEVICE_SI1133, (si1133_status == SI1133_SUCCESS)) != 0) {
+                    SI1133_stack_error(ERROR_BASE_SI1133);
+                }
+                // Check status.
+                if (si1133_status == SI1133_SUCCESS) {
+                    // Store UV index.
+                    _SPSWS_measurement_add_sample(&(spsws_ctx.measurements.sunshine_uv_index), generic_s32_1);
+                }
             }
             POWER_disable(POWER_REQUESTER_ID_MAIN, POWER_DOMAIN_SENSORS);
+            spsws_ctx.measurements_count++;
             // Clear flag.
             spsws_ctx.flags.measure_request = 0;
             // Go to off state.
@@ -1169,6 +2271,8 @@ int main(void) {
 #else
             application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_100BPS;
 #endif
+            // Weather and monitoring messages are sent within the same radio session.
+            _SPSWS_open_sigfox_session();
             _SPSWS_send_sigfox_message(&application_message);
 #ifdef SPSWS_SEN15901_EMULATOR
             GPIO_write(&SPSWS_SEN15901_EMULATOR_SYNCHRO_GPIO, 0);
@@ -1190,9 +2294,26 @@ int main(void) {
                 application_message.bidirectional_flag = SIGFOX_FALSE;
 #endif
                 _SPSWS_send_sigfox_message(&application_message);
+                // Scan stack high-water mark.
+                _SPSWS_update_stack_free();
+                // Send uplink monitoring event message if needed.
+                if (_SPSWS_compute_monitoring_event() != 0) {
+                    application_message.ul_payload = (sfx_u8*) (spsws_ctx.sigfox_ep_ul_payload_monitoring_event.frame);
+                    application_message.ul_payload_size_bytes = SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING_EVENT;
+                    _SPSWS_send_sigfox_message(&application_message);
+                }
+#ifdef SPSWS_PROFILING
+                // Send uplink profiling message.
+                _SPSWS_compute_profiling();
+                application_message.ul_payload = (sfx_u8*) (spsws_ctx.sigfox_ep_ul_payload_profiling.frame);
+                application_message.ul_payload_size_bytes = SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING;
+                _SPSWS_send_sigfox_message(&application_message);
+#endif
                 // Clear request.
                 spsws_ctx.flags.monitoring_request = 0;
             }
+            // Release radio before geolocation.
+            _SPSWS_close_sigfox_session();
             // Compute next state.
             spsws_ctx.state = SPSWS_STATE_GEOLOC;
             break;
@@ -1253,16 +2374,10 @@ int main(void) {
             IWDG_reload();
             // Check request flag.
             if (spsws_ctx.flags.error_stack_request != 0) {
-                // Import Sigfox library error stack.
-                ERROR_import_sigfox_stack();
-                // Check stack.
-                if (ERROR_stack_is_empty() == 0) {
-                    // Read error stack.
-                    for (idx = 0; idx < (SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK >> 1); idx++) {
-                        error_code = ERROR_stack_read();
-                        sigfox_ep_ul_payload_error_stack[(idx << 1) + 0] = (uint8_t) ((error_code >> 8) & 0x00FF);
-                        sigfox_ep_ul_payload_error_stack[(idx << 1) + 1] = (uint8_t) ((error_code >> 0) & 0x00FF);
-                    }
+                // Update error records.
+                _SPSWS_record_errors();
+                // Check records.
+                if (_SPSWS_read_error_records(sigfox_ep_ul_payload_error_stack, SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK) != 0) {
                     // Send frame.
                     application_message.common_parameters.ul_bit_rate = SIGFOX_UL_BIT_RATE_600BPS;
                     application_message.ul_payload = (sfx_u8*) (sigfox_ep_ul_payload_error_stack);
@@ -1309,7 +2424,6 @@ int main(void) {
                 if (por_flag != 0) {
                     // In POR condition, RTC alarm will occur during the first GPS time acquisition because of the RTC reset and the random delay.
                     // Flags are manually cleared to avoid wake-up directly after the first RTC calibration.
-                    spsws_ctx.flags.first_sharp_hour_alarm = 0;
                     spsws_ctx.flags.sharp_hour_alarm = 0;
                     spsws_ctx.flags.weather_request = 0;
                     spsws_ctx.flags.measure_request = 0;
@@ -1338,6 +2452,8 @@ int main(void) {
             break;
         case SPSWS_STATE_TASK_CHECK:
             IWDG_reload();
+            // Deduplicate stacked errors before the stack overflows.
+            _SPSWS_record_errors();
             // Read uptime.
             generic_u32_1 = RTC_get_uptime_seconds();
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
@@ -1360,39 +2476,24 @@ int main(void) {
             }
 #endif
 #endif
-            // Check measurements period.
-            if (generic_u32_1 >= (spsws_ctx.measurements_last_time_seconds + SPSWS_MEASUREMENT_PERIOD_SECONDS)) {
-                // Set request and update last time.
-                spsws_ctx.flags.measure_request = 1;
-                spsws_ctx.measurements_last_time_seconds = generic_u32_1;
-            }
 #ifdef SIGFOX_EP_BIDIRECTIONAL
             // Synchronize weather period.
             if (spsws_ctx.flags.sharp_hour_alarm != 0) {
                 // Clear flag.
                 spsws_ctx.flags.sharp_hour_alarm = 0;
-                // Set requests and update last time.
+                // Set requests.
                 spsws_ctx.flags.monitoring_request = 1;
                 spsws_ctx.flags.weather_request = 1;
                 spsws_ctx.flags.weather_request_intermediate = 0;
-                spsws_ctx.weather_last_time_seconds = spsws_ctx.sharp_hour_uptime;
                 // Reset message count.
                 spsws_ctx.weather_message_count = 1;
-            }
-            else if (spsws_ctx.flags.first_sharp_hour_alarm != 0) {
-                // Get current period.
+                // Schedule intermediate weather slots with the current period.
                 generic_u32_2 = SPSWS_WEATHER_DATA_PERIOD_SECONDS[spsws_ctx.weather_data_period];
-                // Check weather period.
-                if ((generic_u32_1 >= (spsws_ctx.weather_last_time_seconds + generic_u32_2)) && (spsws_ctx.weather_message_count < (3600 / generic_u32_2))) {
-                    // Set request and update last time.
-                    spsws_ctx.flags.weather_request = spsws_ctx.flags.weather_request_enabled;
-                    spsws_ctx.flags.weather_request_intermediate = 1;
-                    spsws_ctx.weather_last_time_seconds = generic_u32_1;
-                    // Update message count.
-                    spsws_ctx.weather_message_count++;
-                }
+                _SPSWS_scheduler_start_task(SPSWS_TASK_ID_WEATHER_INTERMEDIATE, &_SPSWS_weather_intermediate_task_callback, (spsws_ctx.sharp_hour_uptime + generic_u32_2), generic_u32_2);
             }
 #endif
+            // Execute expired tasks.
+            _SPSWS_scheduler_process(generic_u32_1);
             // Go to sleep by default.
             spsws_ctx.state = SPSWS_STATE_SLEEP;
             // Check wake-up flags.
@@ -1430,8 +2531,9 @@ int main(void) {
                 spsws_ctx.state = SPSWS_STATE_MEASURE;
             }
 #ifdef SPSWS_WIND_VANE_ULTIMETER
-            // Measurements must be stopped on any wake-up in order to have the LPTIM available.
-            ultimeter_status = ULTIMETER_set_wind_measurement((spsws_ctx.state == SPSWS_STATE_SLEEP) ? 1 : 0);
+            // Measurements must be stopped during radio activity in order to have the LPTIM available.
+            // Note: sensors and analog delays are redirected to a standard timer while the LPTIM is used by wind measurement.
+            ultimeter_status = ULTIMETER_set_wind_measurement((spsws_ctx.state != SPSWS_STATE_WEATHER) ? 1 : 0);
             ULTIMETER_stack_error(ERROR_BASE_ULTIMETER);
 #endif
             break;
@@ -1439,13 +2541,32 @@ int main(void) {
 #ifdef SIGFOX_EP_BIDIRECTIONAL
             // Check reset request.
             if (spsws_ctx.flags.reset_request != 0) {
+                _SPSWS_clear_crash_record();
                 PWR_software_reset();
             }
 #endif
             // Enter sleep mode.
             IWDG_reload();
-            PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
-            IWDG_reload();
+            generic_u32_1 = RTC_get_uptime_seconds();
+            generic_u32_2 = spsws_ctx.flags.all;
+            // Note: wind speed and rainfall edges are directly counted by the drivers under interrupt,
+            // so the state machine only needs to run when the uptime or a flag has changed.
+            do {
+#ifdef SPSWS_PROFILING
+                profiling_stop_uptime_seconds = RTC_get_uptime_seconds();
+#endif
+                PWR_enter_deepsleep_mode(PWR_DEEPSLEEP_MODE_STOP);
+                IWDG_reload();
+#ifdef SPSWS_PROFILING
+                _SPSWS_update_wake_up_statistics(SPSWS_STATE_SLEEP, profiling_stop_uptime_seconds);
+                spsws_ctx.filtered_wake_up_count++;
+#endif
+            }
+            while ((RTC_get_uptime_seconds() == generic_u32_1) && (spsws_ctx.flags.all == generic_u32_2));
+#ifdef SPSWS_PROFILING
+            // Last wake-up is handled by the state machine.
+            spsws_ctx.filtered_wake_up_count--;
+#endif
             // Check wake-up reason.
             spsws_ctx.state = SPSWS_STATE_TASK_CHECK;
             break;
@@ -1454,6 +2575,9 @@ int main(void) {
             spsws_ctx.state = SPSWS_STATE_TASK_END;
             break;
         }
+#ifdef SPSWS_PROFILING
+        _SPSWS_update_state_statistics(profiling_state, profiling_start_uptime_seconds);
+#endif
     }
     return 0;
 }
@@ -0,0 +1,35 @@
+/*
+ * dps310_hw_ext.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __DPS310_HW_EXT_H__
+#define __DPS310_HW_EXT_H__
+
+#ifndef DPS310_DRIVER_DISABLE_FLAGS_FILE
+#include "dps310_driver_flags.h"
+#endif
+#include "dps310.h"
+#include "sensors_hw.h"
+#include "types.h"
+
+#ifndef DPS310_DRIVER_DISABLE
+
+/*** DPS310 HW EXT functions ***/
+
+/*!******************************************************************
+ * \fn DPS310_status_t DPS310_HW_get_pressure_temperature_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* pressure_pa, int32_t* temperature_tenth_degrees)
+ * \brief Perform a single pressure and temperature measurement with the given oversampling.
+ * \param[in]   i2c_address: I2C address of the sensor.
+ * \param[in]   precision: Pressure oversampling level (high precision is performed by the driver).
+ * \param[out]  pressure_pa: Pointer to integer that will contain the pressure in Pa.
+ * \param[out]  temperature_tenth_degrees: Pointer to integer that will contain the temperature in tenth of degrees.
+ * \retval      Function execution status.
+ *******************************************************************/
+DPS310_status_t DPS310_HW_get_pressure_temperature_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* pressure_pa, int32_t* temperature_tenth_degrees);
+
+#endif /* DPS310_DRIVER_DISABLE */
+
+#endif /* __DPS310_HW_EXT_H__ */
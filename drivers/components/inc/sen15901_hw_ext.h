@@ -0,0 +1,83 @@
+/*
+ * sen15901_hw_ext.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SEN15901_HW_EXT_H__
+#define __SEN15901_HW_EXT_H__
+
+#ifndef SEN15901_DRIVER_DISABLE_FLAGS_FILE
+#include "sen15901_driver_flags.h"
+#endif
+#include "types.h"
+
+#ifndef SEN15901_DRIVER_DISABLE
+
+/*** SEN15901 HW EXT structures ***/
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*!******************************************************************
+ * \enum SEN15901_HW_rainfall_window_t
+ * \brief Rainfall peak intensity sliding windows.
+ *******************************************************************/
+typedef enum {
+    SEN15901_HW_RAINFALL_WINDOW_1_MINUTE = 0,
+    SEN15901_HW_RAINFALL_WINDOW_5_MINUTES,
+    SEN15901_HW_RAINFALL_WINDOW_10_MINUTES,
+    SEN15901_HW_RAINFALL_WINDOW_LAST
+} SEN15901_HW_rainfall_window_t;
+#endif
+
+/*** SEN15901 HW EXT functions ***/
+
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+/*!******************************************************************
+ * \fn void SEN15901_HW_get_wind_direction_confidence(uint32_t* conversion_count, uint8_t* confidence_percent)
+ * \brief Read the confidence of the averaged wind direction since last reset.
+ * \param[in]   none
+ * \param[out]  conversion_count: Pointer to the number of effective vane conversions.
+ * \param[out]  confidence_percent: Pointer to the ratio of conversions which confirmed the previous direction.
+ * \retval      none
+ *******************************************************************/
+void SEN15901_HW_get_wind_direction_confidence(uint32_t* conversion_count, uint8_t* confidence_percent);
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+/*!******************************************************************
+ * \fn void SEN15901_HW_reset_wind_direction_confidence(void)
+ * \brief Reset wind direction confidence statistics.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SEN15901_HW_reset_wind_direction_confidence(void);
+#endif
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*!******************************************************************
+ * \fn void SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_rainfall_window_t window, uint32_t* tip_count, uint32_t* peak_intensity_um_per_hour)
+ * \brief Read the peak rainfall intensity over a sliding window since last log reset.
+ * \param[in]   window: Sliding window.
+ * \param[out]  tip_count: Pointer to the number of bucket tips since last log reset.
+ * \param[out]  peak_intensity_um_per_hour: Pointer to the peak intensity in um per hour.
+ * \retval      none
+ *******************************************************************/
+void SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_rainfall_window_t window, uint32_t* tip_count, uint32_t* peak_intensity_um_per_hour);
+#endif
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*!******************************************************************
+ * \fn void SEN15901_HW_reset_rainfall_log(void)
+ * \brief Reset rainfall bucket tips log and peak intensities.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void SEN15901_HW_reset_rainfall_log(void);
+#endif
+
+#endif /* SEN15901_DRIVER_DISABLE */
+
+#endif /* __SEN15901_HW_EXT_H__ */
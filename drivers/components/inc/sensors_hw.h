@@ -17,6 +17,17 @@
 
 typedef void (*SENSORS_HW_wind_tick_second_irq_cb_t)(void);
 
+/*!******************************************************************
+ * \enum SENSORS_HW_precision_t
+ * \brief Sensors measurement precision levels.
+ *******************************************************************/
+typedef enum {
+    SENSORS_HW_PRECISION_LOW = 0,
+    SENSORS_HW_PRECISION_MEDIUM,
+    SENSORS_HW_PRECISION_HIGH,
+    SENSORS_HW_PRECISION_LAST
+} SENSORS_HW_precision_t;
+
 /*** SENSORS HW functions ***/
 
 /*!******************************************************************
@@ -0,0 +1,35 @@
+/*
+ * sht3x_hw_ext.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __SHT3X_HW_EXT_H__
+#define __SHT3X_HW_EXT_H__
+
+#ifndef SHT3X_DRIVER_DISABLE_FLAGS_FILE
+#include "sht3x_driver_flags.h"
+#endif
+#include "sensors_hw.h"
+#include "sht3x.h"
+#include "types.h"
+
+#ifndef SHT3X_DRIVER_DISABLE
+
+/*** SHT3X HW EXT functions ***/
+
+/*!******************************************************************
+ * \fn SHT3X_status_t SHT3X_HW_get_temperature_humidity_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* temperature_tenth_degrees, int32_t* humidity_percent)
+ * \brief Perform a single shot measurement with the given repeatability.
+ * \param[in]   i2c_address: I2C address of the sensor.
+ * \param[in]   precision: Measurement repeatability (high repeatability is performed by the driver).
+ * \param[out]  temperature_tenth_degrees: Pointer to integer that will contain the temperature in tenth of degrees.
+ * \param[out]  humidity_percent: Pointer to integer that will contain the relative humidity in percent.
+ * \retval      Function execution status.
+ *******************************************************************/
+SHT3X_status_t SHT3X_HW_get_temperature_humidity_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* temperature_tenth_degrees, int32_t* humidity_percent);
+
+#endif /* SHT3X_DRIVER_DISABLE */
+
+#endif /* __SHT3X_HW_EXT_H__ */
@@ -11,12 +11,137 @@
 #include "dps310_driver_flags.h"
 #endif
 #include "dps310.h"
+#include "dps310_hw_ext.h"
 #include "error_base.h"
 #include "sensors_hw.h"
 #include "types.h"
 
 #ifndef DPS310_DRIVER_DISABLE
 
+/*** DPS310 HW local macros ***/
+
+#define DPS310_HW_REGISTER_PSR_B2               0x00
+#define DPS310_HW_REGISTER_TMP_B2               0x03
+#define DPS310_HW_REGISTER_PRS_CFG              0x06
+#define DPS310_HW_REGISTER_MEAS_CFG             0x08
+#define DPS310_HW_REGISTER_COEF                 0x10
+#define DPS310_HW_REGISTER_COEF_SRCE            0x28
+
+#define DPS310_HW_CONFIGURATION_SIZE_BYTES      4
+#define DPS310_HW_COEFFICIENTS_SIZE_BYTES       18
+#define DPS310_HW_RAW_DATA_SIZE_BYTES           3
+
+#define DPS310_HW_MEAS_CFG_COEF_RDY             0x80
+#define DPS310_HW_MEAS_CFG_SENSOR_RDY           0x40
+#define DPS310_HW_MEAS_CTRL_PRESSURE            0x01
+#define DPS310_HW_MEAS_CTRL_TEMPERATURE         0x02
+#define DPS310_HW_COEF_SRCE_TMP_EXT             0x80
+
+#define DPS310_HW_TEMPERATURE_SCALE_FACTOR      524288
+#define DPS310_HW_TEMPERATURE_TIME_MS           4
+
+#define DPS310_HW_FIXED_POINT_SHIFT             16
+
+/*** DPS310 HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t pm_prc;
+    int32_t scale_factor;
+    uint32_t conversion_time_ms;
+} DPS310_HW_oversampling_t;
+
+/*******************************************************************/
+typedef struct {
+    int32_t c0;
+    int32_t c1;
+    int32_t c00;
+    int32_t c10;
+    int32_t c01;
+    int32_t c11;
+    int32_t c20;
+    int32_t c21;
+    int32_t c30;
+} DPS310_HW_coefficients_t;
+
+/*** DPS310 HW local global variables ***/
+
+// Pressure oversampling (high precision is handled by the driver).
+// Note: rates up to 8 do not require the result bit shift.
+static const DPS310_HW_oversampling_t DPS310_HW_OVERSAMPLING[SENSORS_HW_PRECISION_HIGH] = {
+    { 0b0000, 524288, 4 },
+    { 0b0011, 7864320, 15 }
+};
+
+/*** DPS310 HW local functions ***/
+
+/*******************************************************************/
+static int32_t _DPS310_HW_twos_complement(uint32_t value, uint8_t number_of_bits) {
+    // Extend sign bit.
+    return (((value & (0b1UL << (number_of_bits - 1))) != 0) ? ((int32_t) value - (int32_t) (0b1UL << number_of_bits)) : ((int32_t) value));
+}
+
+/*******************************************************************/
+static DPS310_status_t _DPS310_HW_read_registers(uint8_t i2c_address, uint8_t register_address, uint8_t* data, uint8_t data_size_bytes) {
+    // Local variables.
+    DPS310_status_t status = DPS310_SUCCESS;
+    // Select register and read data.
+    status = DPS310_HW_i2c_write(i2c_address, &register_address, 1, 1);
+    if (status != DPS310_SUCCESS) goto errors;
+    status = DPS310_HW_i2c_read(i2c_address, data, data_size_bytes);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static DPS310_status_t _DPS310_HW_write_register(uint8_t i2c_address, uint8_t register_address, uint8_t value) {
+    // Local variables.
+    uint8_t data[2] = { register_address, value };
+    // Write register.
+    return DPS310_HW_i2c_write(i2c_address, data, 2, 1);
+}
+
+/*******************************************************************/
+static DPS310_status_t _DPS310_HW_read_coefficients(uint8_t i2c_address, DPS310_HW_coefficients_t* coefficients) {
+    // Local variables.
+    DPS310_status_t status = DPS310_SUCCESS;
+    uint8_t coef[DPS310_HW_COEFFICIENTS_SIZE_BYTES];
+    // Read calibration coefficients.
+    status = _DPS310_HW_read_registers(i2c_address, DPS310_HW_REGISTER_COEF, coef, DPS310_HW_COEFFICIENTS_SIZE_BYTES);
+    if (status != DPS310_SUCCESS) goto errors;
+    // Unpack values.
+    coefficients->c0 = _DPS310_HW_twos_complement(((((uint32_t) coef[0]) << 4) | (((uint32_t) coef[1]) >> 4)), 12);
+    coefficients->c1 = _DPS310_HW_twos_complement(((((uint32_t) (coef[1] & 0x0F)) << 8) | ((uint32_t) coef[2])), 12);
+    coefficients->c00 = _DPS310_HW_twos_complement(((((uint32_t) coef[3]) << 12) | (((uint32_t) coef[4]) << 4) | (((uint32_t) coef[5]) >> 4)), 20);
+    coefficients->c10 = _DPS310_HW_twos_complement(((((uint32_t) (coef[5] & 0x0F)) << 16) | (((uint32_t) coef[6]) << 8) | ((uint32_t) coef[7])), 20);
+    coefficients->c01 = _DPS310_HW_twos_complement(((((uint32_t) coef[8]) << 8) | ((uint32_t) coef[9])), 16);
+    coefficients->c11 = _DPS310_HW_twos_complement(((((uint32_t) coef[10]) << 8) | ((uint32_t) coef[11])), 16);
+    coefficients->c20 = _DPS310_HW_twos_complement(((((uint32_t) coef[12]) << 8) | ((uint32_t) coef[13])), 16);
+    coefficients->c21 = _DPS310_HW_twos_complement(((((uint32_t) coef[14]) << 8) | ((uint32_t) coef[15])), 16);
+    coefficients->c30 = _DPS310_HW_twos_complement(((((uint32_t) coef[16]) << 8) | ((uint32_t) coef[17])), 16);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static DPS310_status_t _DPS310_HW_read_raw_data(uint8_t i2c_address, uint8_t meas_ctrl, uint32_t conversion_time_ms, int32_t* raw_data) {
+    // Local variables.
+    DPS310_status_t status = DPS310_SUCCESS;
+    uint8_t data[DPS310_HW_RAW_DATA_SIZE_BYTES];
+    // Start single measurement.
+    status = _DPS310_HW_write_register(i2c_address, DPS310_HW_REGISTER_MEAS_CFG, meas_ctrl);
+    if (status != DPS310_SUCCESS) goto errors;
+    // Conversion time.
+    status = DPS310_HW_delay_milliseconds(conversion_time_ms);
+    if (status != DPS310_SUCCESS) goto errors;
+    // Read result.
+    status = _DPS310_HW_read_registers(i2c_address, ((meas_ctrl == DPS310_HW_MEAS_CTRL_PRESSURE) ? DPS310_HW_REGISTER_PSR_B2 : DPS310_HW_REGISTER_TMP_B2), data, DPS310_HW_RAW_DATA_SIZE_BYTES);
+    if (status != DPS310_SUCCESS) goto errors;
+    (*raw_data) = _DPS310_HW_twos_complement(((((uint32_t) data[0]) << 16) | (((uint32_t) data[1]) << 8) | ((uint32_t) data[2])), 24);
+errors:
+    return status;
+}
+
 /*** DPS310 HW functions ***/
 
 /*******************************************************************/
@@ -44,4 +169,75 @@ DPS310_status_t DPS310_HW_delay_milliseconds(uint32_t delay_ms) {
     return ((DPS310_status_t) SENSORS_HW_delay_milliseconds(DPS310_ERROR_BASE_DELAY, delay_ms));
 }
 
+/*** DPS310 HW EXT functions ***/
+
+/*******************************************************************/
+DPS310_status_t DPS310_HW_get_pressure_temperature_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* pressure_pa, int32_t* temperature_tenth_degrees) {
+    // Local variables.
+    DPS310_status_t status = DPS310_SUCCESS;
+    DPS310_status_t restore_status = DPS310_SUCCESS;
+    DPS310_HW_coefficients_t coefficients;
+    uint8_t configuration[DPS310_HW_CONFIGURATION_SIZE_BYTES];
+    uint8_t coef_srce = 0;
+    int32_t raw_temperature = 0;
+    int32_t raw_pressure = 0;
+    int64_t t_sc = 0;
+    int64_t p_sc = 0;
+    int64_t pressure = 0;
+    // Use driver for high precision.
+    if (precision >= SENSORS_HW_PRECISION_HIGH) goto driver_measurement;
+    // Save driver configuration (PRS_CFG, TMP_CFG, MEAS_CFG and CFG_REG).
+    status = _DPS310_HW_read_registers(i2c_address, DPS310_HW_REGISTER_PRS_CFG, configuration, DPS310_HW_CONFIGURATION_SIZE_BYTES);
+    if (status != DPS310_SUCCESS) goto errors;
+    // Use driver if the sensor is not ready.
+    if ((configuration[2] & (DPS310_HW_MEAS_CFG_COEF_RDY | DPS310_HW_MEAS_CFG_SENSOR_RDY)) != (DPS310_HW_MEAS_CFG_COEF_RDY | DPS310_HW_MEAS_CFG_SENSOR_RDY)) goto driver_measurement;
+    // Read coefficients and temperature sensor source.
+    status = _DPS310_HW_read_coefficients(i2c_address, &coefficients);
+    if (status != DPS310_SUCCESS) goto errors;
+    status = _DPS310_HW_read_registers(i2c_address, DPS310_HW_REGISTER_COEF_SRCE, &coef_srce, 1);
+    if (status != DPS310_SUCCESS) goto errors;
+    // Configure single rate conversions.
+    status = _DPS310_HW_write_register(i2c_address, DPS310_HW_REGISTER_PRS_CFG, DPS310_HW_OVERSAMPLING[precision].pm_prc);
+    if (status != DPS310_SUCCESS) goto restore;
+    status = _DPS310_HW_write_register(i2c_address, (DPS310_HW_REGISTER_PRS_CFG + 1), (coef_srce & DPS310_HW_COEF_SRCE_TMP_EXT));
+    if (status != DPS310_SUCCESS) goto restore;
+    status = _DPS310_HW_write_register(i2c_address, (DPS310_HW_REGISTER_PRS_CFG + 3), 0x00);
+    if (status != DPS310_SUCCESS) goto restore;
+    // Perform measurements.
+    status = _DPS310_HW_read_raw_data(i2c_address, DPS310_HW_MEAS_CTRL_TEMPERATURE, DPS310_HW_TEMPERATURE_TIME_MS, &raw_temperature);
+    if (status != DPS310_SUCCESS) goto restore;
+    status = _DPS310_HW_read_raw_data(i2c_address, DPS310_HW_MEAS_CTRL_PRESSURE, DPS310_HW_OVERSAMPLING[precision].conversion_time_ms, &raw_pressure);
+    if (status != DPS310_SUCCESS) goto restore;
+    // Scaled raw values in fixed point.
+    t_sc = (((int64_t) raw_temperature) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) / DPS310_HW_TEMPERATURE_SCALE_FACTOR;
+    p_sc = (((int64_t) raw_pressure) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) / DPS310_HW_OVERSAMPLING[precision].scale_factor;
+    // Compensated temperature: c0 / 2 + c1 * T_sc.
+    (*temperature_tenth_degrees) = (int32_t) ((((int64_t) coefficients.c0) * 5) + ((((int64_t) coefficients.c1) * t_sc * 10) >> DPS310_HW_FIXED_POINT_SHIFT));
+    // Compensated pressure: c00 + P_sc * (c10 + P_sc * (c20 + P_sc * c30)) + T_sc * c01 + T_sc * P_sc * (c11 + P_sc * c21).
+    pressure = (((int64_t) coefficients.c20) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) + (((int64_t) coefficients.c30) * p_sc);
+    pressure = (((int64_t) coefficients.c10) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) + ((pressure * p_sc) >> DPS310_HW_FIXED_POINT_SHIFT);
+    pressure = (((int64_t) coefficients.c00) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) + ((pressure * p_sc) >> DPS310_HW_FIXED_POINT_SHIFT);
+    pressure += (((int64_t) coefficients.c01) * t_sc);
+    pressure += ((((((((int64_t) coefficients.c11) * (1 << DPS310_HW_FIXED_POINT_SHIFT)) + (((int64_t) coefficients.c21) * p_sc)) * p_sc) >> DPS310_HW_FIXED_POINT_SHIFT) * t_sc) >> DPS310_HW_FIXED_POINT_SHIFT);
+    (*pressure_pa) = (int32_t) ((pressure + (1 << (DPS310_HW_FIXED_POINT_SHIFT - 1))) >> DPS310_HW_FIXED_POINT_SHIFT);
+restore:
+    // Restore driver configuration.
+    restore_status = _DPS310_HW_write_register(i2c_address, DPS310_HW_REGISTER_PRS_CFG, configuration[0]);
+    if (restore_status == DPS310_SUCCESS) {
+        restore_status = _DPS310_HW_write_register(i2c_address, (DPS310_HW_REGISTER_PRS_CFG + 1), configuration[1]);
+    }
+    if (restore_status == DPS310_SUCCESS) {
+        restore_status = _DPS310_HW_write_register(i2c_address, (DPS310_HW_REGISTER_PRS_CFG + 3), configuration[3]);
+    }
+    if (status == DPS310_SUCCESS) {
+        status = restore_status;
+    }
+    goto errors;
+driver_measurement:
+    // Fall back on driver oversampling.
+    status = DPS310_get_pressure_temperature(i2c_address, pressure_pa, temperature_tenth_degrees);
+errors:
+    return status;
+}
+
 #endif /* DPS310_DRIVER_DISABLE */
@@ -16,6 +16,7 @@
 #include "lptim.h"
 #include "max111xx.h"
 #include "mcu_mapping.h"
+#include "sensors_hw.h"
 #include "spi.h"
 #include "types.h"
 
@@ -91,14 +92,7 @@ errors:
 
 /*******************************************************************/
 MAX111XX_status_t MAX111XX_HW_delay_milliseconds(uint32_t delay_ms) {
-    // Local variables.
-    MAX111XX_status_t status = MAX111XX_SUCCESS;
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
-    // Perform delay.
-    lptim_status = LPTIM_delay_milliseconds(delay_ms, LPTIM_DELAY_MODE_SLEEP);
-    LPTIM_exit_error(MAX111XX_ERROR_BASE_DELAY);
-errors:
-    return status;
+    return ((MAX111XX_status_t) SENSORS_HW_delay_milliseconds(MAX111XX_ERROR_BASE_DELAY, delay_ms));
 }
 
 #endif /* MAX111XX_DRIVER_DISABLE */
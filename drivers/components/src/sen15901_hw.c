@@ -17,7 +17,9 @@
 #include "nvic.h"
 #include "nvic_priority.h"
 #include "power.h"
+#include "rtc.h"
 #include "sen15901.h"
+#include "sen15901_hw_ext.h"
 #include "sensors_hw.h"
 #include "types.h"
 
@@ -28,6 +30,124 @@
 #define SEN15901_HW_GPIO_WIND_SPEED     GPIO_DIO0
 #define SEN15901_HW_GPIO_RAINFALL       GPIO_DIO2
 
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+// Adaptive wind direction sampling.
+#define SEN15901_HW_WIND_DIRECTION_CHANGE_THRESHOLD_PERMILLE    25
+#define SEN15901_HW_WIND_DIRECTION_HOLD_PERIOD_MAX              5
+// About 10km/h (2.4km/h per Hz).
+#define SEN15901_HW_WIND_SPEED_HIGH_EDGE_COUNT                  (SEN15901_DRIVER_WIND_DIRECTION_SAMPLING_PERIOD_SECONDS * 4)
+#endif
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+// Bucket tips timestamps log (must be a power of 2).
+// Note: peaks are updated on each tip, so the log only has to cover the longest window (10 minutes at 210mm/h).
+#define SEN15901_HW_RAINFALL_LOG_SIZE                           128
+#define SEN15901_HW_RAINFALL_TIP_UM                             279
+#endif
+
+/*** SEN15901_HW local structures ***/
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*******************************************************************/
+typedef struct {
+    uint32_t start_index;
+    uint32_t peak_tip_count;
+} SEN15901_HW_rainfall_peak_t;
+#endif
+
+/*******************************************************************/
+typedef struct {
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+    void (*rainfall_edge_irq_callback)(void);
+    volatile uint32_t rainfall_tip_count;
+    uint16_t rainfall_tip_log[SEN15901_HW_RAINFALL_LOG_SIZE];
+    volatile SEN15901_HW_rainfall_peak_t rainfall_peak[SEN15901_HW_RAINFALL_WINDOW_LAST];
+#endif
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+    void (*wind_speed_edge_irq_callback)(void);
+    volatile uint32_t wind_speed_edge_count;
+    uint32_t wind_speed_edge_count_previous;
+    int32_t wind_direction_ratio_permille;
+    uint8_t wind_direction_ratio_valid;
+    uint8_t wind_direction_hold_count;
+    uint8_t wind_direction_hold_period;
+    uint32_t wind_direction_conversion_count;
+    uint32_t wind_direction_change_count;
+#endif
+} SEN15901_HW_context_t;
+
+/*** SEN15901_HW local global variables ***/
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+static const uint16_t SEN15901_HW_RAINFALL_WINDOW_SECONDS[SEN15901_HW_RAINFALL_WINDOW_LAST] = { 60, 300, 600 };
+#endif
+
+static SEN15901_HW_context_t sen15901_hw_ctx = {
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+    .rainfall_edge_irq_callback = NULL,
+    .rainfall_tip_count = 0,
+#endif
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+    .wind_speed_edge_irq_callback = NULL,
+    .wind_speed_edge_count = 0,
+    .wind_speed_edge_count_previous = 0,
+    .wind_direction_ratio_permille = 0,
+    .wind_direction_ratio_valid = 0,
+    .wind_direction_hold_count = 0,
+    .wind_direction_hold_period = 0,
+    .wind_direction_conversion_count = 0,
+    .wind_direction_change_count = 0,
+#endif
+};
+
+/*** SEN15901 HW local functions ***/
+
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+/*******************************************************************/
+static void _SEN15901_HW_wind_speed_edge_irq_callback(void) {
+    // Count edges for direction sampling period computation.
+    sen15901_hw_ctx.wind_speed_edge_count++;
+    // Forward to driver.
+    if (sen15901_hw_ctx.wind_speed_edge_irq_callback != NULL) {
+        sen15901_hw_ctx.wind_speed_edge_irq_callback();
+    }
+}
+#endif
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*******************************************************************/
+static void _SEN15901_HW_rainfall_edge_irq_callback(void) {
+    // Local variables.
+    volatile SEN15901_HW_rainfall_peak_t* peak = NULL;
+    uint32_t tip_index = sen15901_hw_ctx.rainfall_tip_count;
+    uint32_t window_tip_count = 0;
+    uint16_t tip_time = (uint16_t) RTC_get_uptime_seconds();
+    uint8_t idx = 0;
+    // Log tip timestamp.
+    sen15901_hw_ctx.rainfall_tip_log[tip_index & (SEN15901_HW_RAINFALL_LOG_SIZE - 1)] = tip_time;
+    // Update running peaks of the windows ending on this tip (amortized constant time).
+    for (idx = 0; idx < SEN15901_HW_RAINFALL_WINDOW_LAST; idx++) {
+        peak = &(sen15901_hw_ctx.rainfall_peak[idx]);
+        // Skip overwritten entries (or stale index if the log has just been reset).
+        if (((peak->start_index) > tip_index) || ((tip_index - (peak->start_index)) >= SEN15901_HW_RAINFALL_LOG_SIZE)) {
+            peak->start_index = (tip_index - SEN15901_HW_RAINFALL_LOG_SIZE + 1);
+        }
+        // Note: 16-bits timestamps difference remains valid across counter rollover.
+        while (((peak->start_index) < tip_index) && (((uint16_t) (tip_time - sen15901_hw_ctx.rainfall_tip_log[(peak->start_index) & (SEN15901_HW_RAINFALL_LOG_SIZE - 1)])) >= SEN15901_HW_RAINFALL_WINDOW_SECONDS[idx])) {
+            peak->start_index++;
+        }
+        window_tip_count = ((tip_index - (peak->start_index)) + 1);
+        if (window_tip_count > (peak->peak_tip_count)) {
+            peak->peak_tip_count = window_tip_count;
+        }
+    }
+    sen15901_hw_ctx.rainfall_tip_count++;
+    // Forward to driver.
+    if (sen15901_hw_ctx.rainfall_edge_irq_callback != NULL) {
+        sen15901_hw_ctx.rainfall_edge_irq_callback();
+    }
+}
+#endif
+
 /*** SEN15901 HW functions ***/
 
 /*******************************************************************/
@@ -36,14 +156,20 @@ SEN15901_status_t SEN15901_HW_init(SEN15901_HW_configuration_t* configuration) {
     SEN15901_status_t status = SEN15901_SUCCESS;
 #ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
     // Init wind speed GPIO.
-    EXTI_configure_gpio(&SEN15901_HW_GPIO_WIND_SPEED, GPIO_PULL_NONE, EXTI_TRIGGER_FALLING_EDGE, (configuration->wind_speed_edge_irq_callback), NVIC_PRIORITY_WIND_SPEED);
+    sen15901_hw_ctx.wind_speed_edge_irq_callback = (configuration->wind_speed_edge_irq_callback);
+    sen15901_hw_ctx.wind_speed_edge_count = 0;
+    sen15901_hw_ctx.wind_speed_edge_count_previous = 0;
+    sen15901_hw_ctx.wind_direction_ratio_valid = 0;
+    EXTI_configure_gpio(&SEN15901_HW_GPIO_WIND_SPEED, GPIO_PULL_NONE, EXTI_TRIGGER_FALLING_EDGE, &_SEN15901_HW_wind_speed_edge_irq_callback, NVIC_PRIORITY_WIND_SPEED);
     // Store tick second callback which will be used in main (RTC).
     SENSORS_HW_set_wind_tick_second_callback(configuration->tick_second_irq_callback);
     // Note: ADC will be initialized in the power enable function.
 #endif
 #ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
     // Init rainfall GPIO.
-    EXTI_configure_gpio(&SEN15901_HW_GPIO_RAINFALL, GPIO_PULL_NONE, EXTI_TRIGGER_FALLING_EDGE, (configuration->rainfall_edge_irq_callback), NVIC_PRIORITY_RAINFALL);
+    sen15901_hw_ctx.rainfall_edge_irq_callback = (configuration->rainfall_edge_irq_callback);
+    sen15901_hw_ctx.rainfall_tip_count = 0;
+    EXTI_configure_gpio(&SEN15901_HW_GPIO_RAINFALL, GPIO_PULL_NONE, EXTI_TRIGGER_FALLING_EDGE, &_SEN15901_HW_rainfall_edge_irq_callback, NVIC_PRIORITY_RAINFALL);
 #endif
     return status;
 }
@@ -85,14 +211,53 @@ SEN15901_status_t SEN15901_HW_adc_get_wind_direction_ratio(int32_t* wind_directi
     // Local variables.
     SEN15901_status_t status = SEN15901_SUCCESS;
     ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    uint32_t edge_count_snapshot = 0;
+    uint32_t edge_count = 0;
+    int32_t ratio_delta = 0;
+    // Compute edges of the last period.
+    // Note: the counter is only incremented by the interrupt and never cleared here, so that a single 32-bits read is atomic.
+    edge_count_snapshot = sen15901_hw_ctx.wind_speed_edge_count;
+    edge_count = (edge_count_snapshot - sen15901_hw_ctx.wind_speed_edge_count_previous);
+    sen15901_hw_ctx.wind_speed_edge_count_previous = edge_count_snapshot;
+    // Hold previous direction if the vane is stable and wind is low.
+    if ((sen15901_hw_ctx.wind_direction_ratio_valid != 0) && (edge_count < SEN15901_HW_WIND_SPEED_HIGH_EDGE_COUNT) && (sen15901_hw_ctx.wind_direction_hold_count < sen15901_hw_ctx.wind_direction_hold_period)) {
+        sen15901_hw_ctx.wind_direction_hold_count++;
+        (*wind_direction_ratio_permille) = sen15901_hw_ctx.wind_direction_ratio_permille;
+        goto end;
+    }
+    sen15901_hw_ctx.wind_direction_hold_count = 0;
     // Turn external ADC on.
     POWER_enable(POWER_REQUESTER_ID_SEN15901, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_SLEEP);
     // Get direction from ADC.
     analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_WIND_DIRECTION_RATIO_PERMILLE, wind_direction_ratio_permille);
     ANALOG_exit_error(SEN15901_ERROR_BASE_ADC);
+    // Detect direction change.
+    ratio_delta = (*wind_direction_ratio_permille) - sen15901_hw_ctx.wind_direction_ratio_permille;
+    if (ratio_delta < 0) {
+        ratio_delta = (-ratio_delta);
+    }
+    sen15901_hw_ctx.wind_direction_conversion_count++;
+    if ((sen15901_hw_ctx.wind_direction_ratio_valid != 0) && (ratio_delta > SEN15901_HW_WIND_DIRECTION_CHANGE_THRESHOLD_PERMILLE)) {
+        sen15901_hw_ctx.wind_direction_change_count++;
+        sen15901_hw_ctx.wind_direction_hold_period = 0;
+    }
+    else if (edge_count >= SEN15901_HW_WIND_SPEED_HIGH_EDGE_COUNT) {
+        sen15901_hw_ctx.wind_direction_hold_period = 0;
+    }
+    else if (edge_count == 0) {
+        // Calm: the vane can not move.
+        sen15901_hw_ctx.wind_direction_hold_period = SEN15901_HW_WIND_DIRECTION_HOLD_PERIOD_MAX;
+    }
+    else if (sen15901_hw_ctx.wind_direction_hold_period < SEN15901_HW_WIND_DIRECTION_HOLD_PERIOD_MAX) {
+        sen15901_hw_ctx.wind_direction_hold_period++;
+    }
+    // Store new direction.
+    sen15901_hw_ctx.wind_direction_ratio_permille = (*wind_direction_ratio_permille);
+    sen15901_hw_ctx.wind_direction_ratio_valid = 1;
 errors:
     // Turn external ADC off.
     POWER_disable(POWER_REQUESTER_ID_SEN15901, POWER_DOMAIN_ANALOG);
+end:
     return status;
 }
 #endif
@@ -114,4 +279,55 @@ SEN15901_status_t SEN15901_HW_set_rainfall_interrupt(uint8_t enable) {
 }
 #endif
 
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+/*******************************************************************/
+void SEN15901_HW_get_wind_direction_confidence(uint32_t* conversion_count, uint8_t* confidence_percent) {
+    // Read statistics.
+    (*conversion_count) = sen15901_hw_ctx.wind_direction_conversion_count;
+    (*confidence_percent) = 0;
+    // Compute ratio of conversions which confirmed the previous direction.
+    if (sen15901_hw_ctx.wind_direction_conversion_count > 0) {
+        (*confidence_percent) = (uint8_t) ((100 * (sen15901_hw_ctx.wind_direction_conversion_count - sen15901_hw_ctx.wind_direction_change_count)) / (sen15901_hw_ctx.wind_direction_conversion_count));
+    }
+}
+#endif
+
+#ifdef SEN15901_DRIVER_WIND_MEASUREMENTS_ENABLE
+/*******************************************************************/
+void SEN15901_HW_reset_wind_direction_confidence(void) {
+    // Reset statistics.
+    sen15901_hw_ctx.wind_direction_conversion_count = 0;
+    sen15901_hw_ctx.wind_direction_change_count = 0;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*******************************************************************/
+void SEN15901_HW_get_rainfall_peak_intensity(SEN15901_HW_rainfall_window_t window, uint32_t* tip_count, uint32_t* peak_intensity_um_per_hour) {
+    // Reset outputs.
+    (*tip_count) = sen15901_hw_ctx.rainfall_tip_count;
+    (*peak_intensity_um_per_hour) = 0;
+    // Check window.
+    if (window >= SEN15901_HW_RAINFALL_WINDOW_LAST) goto errors;
+    // Convert to intensity.
+    (*peak_intensity_um_per_hour) = (sen15901_hw_ctx.rainfall_peak[window].peak_tip_count * SEN15901_HW_RAINFALL_TIP_UM * 3600) / ((uint32_t) SEN15901_HW_RAINFALL_WINDOW_SECONDS[window]);
+errors:
+    return;
+}
+#endif
+
+#ifdef SEN15901_DRIVER_RAINFALL_MEASUREMENTS_ENABLE
+/*******************************************************************/
+void SEN15901_HW_reset_rainfall_log(void) {
+    // Local variables.
+    uint8_t idx = 0;
+    // Reset tips counter and peaks.
+    sen15901_hw_ctx.rainfall_tip_count = 0;
+    for (idx = 0; idx < SEN15901_HW_RAINFALL_WINDOW_LAST; idx++) {
+        sen15901_hw_ctx.rainfall_peak[idx].start_index = 0;
+        sen15901_hw_ctx.rainfall_peak[idx].peak_tip_count = 0;
+    }
+}
+#endif
+
 #endif /* SEN15901_DRIVER_DISABLE */
@@ -7,6 +7,7 @@
 
 #include "sensors_hw.h"
 
+#include "delay_arbiter.h"
 #include "error.h"
 #include "error_base.h"
 #include "i2c.h"
@@ -80,11 +81,18 @@ errors:
 ERROR_code_t SENSORS_HW_delay_milliseconds(ERROR_code_t delay_error_base, uint32_t delay_ms) {
     // Local variables.
     ERROR_code_t status = SUCCESS;
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    DELAY_ARBITER_status_t delay_arbiter_status = DELAY_ARBITER_SUCCESS;
     // Perform delay.
-    lptim_status = LPTIM_delay_milliseconds(delay_ms, LPTIM_DELAY_MODE_SLEEP);
-    LPTIM_exit_error(delay_error_base);
-errors:
+    delay_arbiter_status = DELAY_ARBITER_milliseconds(delay_ms, LPTIM_DELAY_MODE_SLEEP);
+    // Check status.
+    if (delay_arbiter_status >= DELAY_ARBITER_ERROR_BASE_TIM) {
+        // Drivers delay error base only covers LPTIM codes: stack the delay timer error and report the LPTIM as busy.
+        DELAY_ARBITER_stack_error(ERROR_BASE_DELAY_ARBITER);
+        status = (delay_error_base + LPTIM_ERROR_ALREADY_RUNNING);
+    }
+    else if (delay_arbiter_status != DELAY_ARBITER_SUCCESS) {
+        status = (delay_error_base + (delay_arbiter_status - DELAY_ARBITER_ERROR_BASE_LPTIM));
+    }
     return status;
 }
 
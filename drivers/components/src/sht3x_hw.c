@@ -13,10 +13,53 @@
 #include "error_base.h"
 #include "sensors_hw.h"
 #include "sht3x.h"
+#include "sht3x_hw_ext.h"
 #include "types.h"
 
 #ifndef SHT3X_DRIVER_DISABLE
 
+/*** SHT3X HW local macros ***/
+
+#define SHT3X_HW_SINGLE_SHOT_COMMAND_SIZE_BYTES     2
+#define SHT3X_HW_SINGLE_SHOT_RESPONSE_SIZE_BYTES    6
+
+#define SHT3X_HW_CRC_POLYNOMIAL                     0x31
+#define SHT3X_HW_CRC_INIT                           0xFF
+
+/*** SHT3X HW local structures ***/
+
+/*******************************************************************/
+typedef struct {
+    uint8_t command[SHT3X_HW_SINGLE_SHOT_COMMAND_SIZE_BYTES];
+    uint32_t conversion_time_ms;
+} SHT3X_HW_single_shot_t;
+
+/*** SHT3X HW local global variables ***/
+
+// Single shot commands without clock stretching (high repeatability is handled by the driver).
+static const SHT3X_HW_single_shot_t SHT3X_HW_SINGLE_SHOT[SENSORS_HW_PRECISION_HIGH] = {
+    { { 0x24, 0x16 }, 5 },
+    { { 0x24, 0x0B }, 7 }
+};
+
+/*** SHT3X HW local functions ***/
+
+/*******************************************************************/
+static uint8_t _SHT3X_HW_compute_crc(uint8_t* data, uint8_t data_size_bytes) {
+    // Local variables.
+    uint8_t crc = SHT3X_HW_CRC_INIT;
+    uint8_t idx = 0;
+    uint8_t bit_idx = 0;
+    // Bytes loop.
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        crc ^= data[idx];
+        for (bit_idx = 0; bit_idx < 8; bit_idx++) {
+            crc = ((crc & 0x80) != 0) ? ((uint8_t) ((crc << 1) ^ SHT3X_HW_CRC_POLYNOMIAL)) : ((uint8_t) (crc << 1));
+        }
+    }
+    return crc;
+}
+
 /*** SHT3X HW functions ***/
 
 /*******************************************************************/
@@ -44,4 +87,42 @@ SHT3X_status_t SHT3X_HW_delay_milliseconds(uint32_t delay_ms) {
     return ((SHT3X_status_t) SENSORS_HW_delay_milliseconds(SHT3X_ERROR_BASE_DELAY, delay_ms));
 }
 
+/*** SHT3X HW EXT functions ***/
+
+/*******************************************************************/
+SHT3X_status_t SHT3X_HW_get_temperature_humidity_precision(uint8_t i2c_address, SENSORS_HW_precision_t precision, int32_t* temperature_tenth_degrees, int32_t* humidity_percent) {
+    // Local variables.
+    SHT3X_status_t status = SHT3X_SUCCESS;
+    uint8_t command[SHT3X_HW_SINGLE_SHOT_COMMAND_SIZE_BYTES];
+    uint8_t response[SHT3X_HW_SINGLE_SHOT_RESPONSE_SIZE_BYTES];
+    int32_t raw_value = 0;
+    // Use driver for high repeatability.
+    if (precision >= SENSORS_HW_PRECISION_HIGH) goto driver_measurement;
+    // Single shot command.
+    command[0] = SHT3X_HW_SINGLE_SHOT[precision].command[0];
+    command[1] = SHT3X_HW_SINGLE_SHOT[precision].command[1];
+    status = SHT3X_HW_i2c_write(i2c_address, command, SHT3X_HW_SINGLE_SHOT_COMMAND_SIZE_BYTES, 1);
+    if (status != SHT3X_SUCCESS) goto errors;
+    // Conversion time.
+    status = SHT3X_HW_delay_milliseconds(SHT3X_HW_SINGLE_SHOT[precision].conversion_time_ms);
+    if (status != SHT3X_SUCCESS) goto errors;
+    // Read result.
+    status = SHT3X_HW_i2c_read(i2c_address, response, SHT3X_HW_SINGLE_SHOT_RESPONSE_SIZE_BYTES);
+    if (status != SHT3X_SUCCESS) goto errors;
+    // Check CRC.
+    if ((_SHT3X_HW_compute_crc(&(response[0]), 2) != response[2]) || (_SHT3X_HW_compute_crc(&(response[3]), 2) != response[5])) goto driver_measurement;
+    // Compute temperature.
+    raw_value = (int32_t) ((((uint32_t) response[0]) << 8) + ((uint32_t) response[1]));
+    (*temperature_tenth_degrees) = ((1750 * raw_value) / 65535) - 450;
+    // Compute humidity.
+    raw_value = (int32_t) ((((uint32_t) response[3]) << 8) + ((uint32_t) response[4]));
+    (*humidity_percent) = (100 * raw_value) / 65535;
+    goto errors;
+driver_measurement:
+    // Fall back on driver default repeatability.
+    status = SHT3X_get_temperature_humidity(i2c_address, temperature_tenth_degrees, humidity_percent);
+errors:
+    return status;
+}
+
 #endif /* SHT3X_DRIVER_DISABLE */
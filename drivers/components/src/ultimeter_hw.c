@@ -11,6 +11,7 @@
 #include "ultimeter_driver_flags.h"
 #endif
 #include "error.h"
+#include "delay_arbiter.h"
 #include "error_base.h"
 #include "exti.h"
 #include "gpio.h"
@@ -80,6 +81,8 @@ ULTIMETER_status_t ULTIMETER_HW_timer_start(void) {
     // Start timer.
     lptim_status = LPTIM_start(LPTIM_CLOCK_PRESCALER_4);
     LPTIM_exit_error(ULTIMETER_ERROR_BASE_TIMER);
+    // Redirect other delays.
+    DELAY_ARBITER_set_lptim_owner(1);
 errors:
     return status;
 }
@@ -89,6 +92,8 @@ ULTIMETER_status_t ULTIMETER_HW_timer_stop(void) {
     // Local variables.
     ULTIMETER_status_t status = ULTIMETER_SUCCESS;
     LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    // Release LPTIM.
+    DELAY_ARBITER_set_lptim_owner(0);
     // Stop timer.
     lptim_status = LPTIM_stop();
     LPTIM_stack_error(ERROR_BASE_ULTIMETER + ULTIMETER_ERROR_BASE_TIMER);
@@ -0,0 +1,65 @@
+/*
+ * delay_arbiter.h
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#ifndef __DELAY_ARBITER_H__
+#define __DELAY_ARBITER_H__
+
+#include "error.h"
+#include "lptim.h"
+#include "spsws_flags.h"
+#include "tim.h"
+#include "types.h"
+
+/*** DELAY ARBITER structures ***/
+
+/*!******************************************************************
+ * \enum DELAY_ARBITER_status_t
+ * \brief DELAY ARBITER driver error codes.
+ *******************************************************************/
+typedef enum {
+    // Driver errors.
+    DELAY_ARBITER_SUCCESS = 0,
+    // Low level drivers errors.
+    DELAY_ARBITER_ERROR_BASE_LPTIM = ERROR_BASE_STEP,
+    DELAY_ARBITER_ERROR_BASE_TIM = (DELAY_ARBITER_ERROR_BASE_LPTIM + LPTIM_ERROR_BASE_LAST),
+    // Last base value.
+    DELAY_ARBITER_ERROR_BASE_LAST = (DELAY_ARBITER_ERROR_BASE_TIM + TIM_ERROR_BASE_LAST)
+} DELAY_ARBITER_status_t;
+
+/*** DELAY ARBITER functions ***/
+
+/*!******************************************************************
+ * \fn DELAY_ARBITER_status_t DELAY_ARBITER_milliseconds(uint32_t delay_ms, LPTIM_delay_mode_t delay_mode)
+ * \brief Delay function using the LPTIM, or the delay timer when the LPTIM is owned by wind measurement.
+ * \param[in]   delay_ms: Delay to wait in ms.
+ * \param[in]   delay_mode: Delay waiting mode (sleep mode is always used with the delay timer).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+DELAY_ARBITER_status_t DELAY_ARBITER_milliseconds(uint32_t delay_ms, LPTIM_delay_mode_t delay_mode);
+
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && (defined SPSWS_WIND_VANE_ULTIMETER))
+/*!******************************************************************
+ * \fn void DELAY_ARBITER_set_lptim_owner(uint8_t owner_flag)
+ * \brief Declare the LPTIM as used by wind measurement.
+ * \param[in]   owner_flag: Set while the wind driver timer is running.
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void DELAY_ARBITER_set_lptim_owner(uint8_t owner_flag);
+#endif
+
+/*******************************************************************/
+#define DELAY_ARBITER_exit_error(base) { ERROR_check_exit(delay_arbiter_status, DELAY_ARBITER_SUCCESS, base) }
+
+/*******************************************************************/
+#define DELAY_ARBITER_stack_error(base) { ERROR_check_stack(delay_arbiter_status, DELAY_ARBITER_SUCCESS, base) }
+
+/*******************************************************************/
+#define DELAY_ARBITER_stack_exit_error(base, code) { ERROR_check_stack_exit(delay_arbiter_status, DELAY_ARBITER_SUCCESS, base, code) }
+
+#endif /* __DELAY_ARBITER_H__ */
@@ -28,6 +28,7 @@
 
 #define TIM_INSTANCE_MCU_API            TIM_INSTANCE_TIM2
 #define TIM_INSTANCE_RF_API             TIM_INSTANCE_TIM22
+#define TIM_INSTANCE_DELAY              TIM_INSTANCE_TIM21
 
 #ifdef HW1_0
 #define USART_INSTANCE_AT               USART_INSTANCE_USART2
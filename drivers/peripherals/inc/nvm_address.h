@@ -37,6 +37,16 @@ typedef enum {
     NVM_ADDRESS_LAST_DOWNLINK_STATUS,
     // Weather data period.
     NVM_ADDRESS_WEATHER_DATA_PERIOD,
+    // Analog calibration (gain correction and offset).
+    NVM_ADDRESS_ANALOG_CALIBRATION_SOURCE_VOLTAGE,
+    NVM_ADDRESS_ANALOG_CALIBRATION_STORAGE_VOLTAGE = (NVM_ADDRESS_ANALOG_CALIBRATION_SOURCE_VOLTAGE + 4),
+    // Sigfox provisioning block CRC.
+    NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC = (NVM_ADDRESS_ANALOG_CALIBRATION_STORAGE_VOLTAGE + 4),
+    // Sensors precision policy (0 = default, 1 = low, 2 = medium, 3 = high).
+    NVM_ADDRESS_SENSORS_PRECISION = (NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC + 2),
+    // Last profiling period (uplink frame and sleep wake-up sources counters).
+    NVM_ADDRESS_PROFILING_FRAME = (NVM_ADDRESS_SENSORS_PRECISION + 3),
+    NVM_ADDRESS_PROFILING_WAKE_UP_COUNT = (NVM_ADDRESS_PROFILING_FRAME + 5),
 } NVM_address_t;
 
 #endif /* __NVM_ADDRESS_H__ */
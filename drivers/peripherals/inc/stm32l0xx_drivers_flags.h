@@ -22,7 +22,9 @@
 #define STM32L0XX_DRIVERS_EXTI_GPIO_MASK                0x8C03
 #endif
 
-//#define STM32L0XX_DRIVERS_I2C_FAST_MODE
+#ifdef SPSWS_I2C_FAST_MODE
+#define STM32L0XX_DRIVERS_I2C_FAST_MODE
+#endif
 
 //#define STM32L0XX_DRIVERS_LPUART_RS485
 #define STM32L0XX_DRIVERS_LPUART_HIGH_BAUD_RATE
@@ -0,0 +1,83 @@
+/*
+ * delay_arbiter.c
+ *
+ *  Created on: 18 oct. 2026
+ *      Author: Ludo
+ */
+
+#include "delay_arbiter.h"
+
+#include "error.h"
+#include "lptim.h"
+#include "mcu_mapping.h"
+#include "nvic_priority.h"
+#include "pwr.h"
+#include "spsws_flags.h"
+#include "tim.h"
+#include "types.h"
+
+/*** DELAY ARBITER local global variables ***/
+
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && (defined SPSWS_WIND_VANE_ULTIMETER))
+static volatile uint8_t delay_arbiter_lptim_owner = 0;
+static volatile uint8_t delay_arbiter_tim_irq_flag = 0;
+#endif
+
+/*** DELAY ARBITER local functions ***/
+
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && (defined SPSWS_WIND_VANE_ULTIMETER))
+/*******************************************************************/
+static void _DELAY_ARBITER_tim_irq_callback(void) {
+    // Set flag.
+    delay_arbiter_tim_irq_flag = 1;
+}
+#endif
+
+/*** DELAY ARBITER functions ***/
+
+/*******************************************************************/
+DELAY_ARBITER_status_t DELAY_ARBITER_milliseconds(uint32_t delay_ms, LPTIM_delay_mode_t delay_mode) {
+    // Local variables.
+    DELAY_ARBITER_status_t status = DELAY_ARBITER_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && (defined SPSWS_WIND_VANE_ULTIMETER))
+    TIM_status_t tim_status = TIM_SUCCESS;
+    TIM_status_t tim_status_de_init = TIM_SUCCESS;
+    // Check LPTIM owner.
+    if (delay_arbiter_lptim_owner != 0) {
+        // Note: the delay timer is not shared with the Sigfox library, so the delay is never skipped.
+        // Stop mode is replaced by sleep mode.
+        tim_status = TIM_STD_init(TIM_INSTANCE_DELAY, NVIC_PRIORITY_DELAY);
+        TIM_exit_error(DELAY_ARBITER_ERROR_BASE_TIM);
+        delay_arbiter_tim_irq_flag = 0;
+        tim_status = TIM_STD_start(TIM_INSTANCE_DELAY, delay_ms, TIM_UNIT_MS, &_DELAY_ARBITER_tim_irq_callback);
+        if (tim_status == TIM_SUCCESS) {
+            // Wait for the first period.
+            while (delay_arbiter_tim_irq_flag == 0) {
+                PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
+            }
+            tim_status = TIM_STD_stop(TIM_INSTANCE_DELAY);
+        }
+        // Release timer in all cases.
+        tim_status_de_init = TIM_STD_de_init(TIM_INSTANCE_DELAY);
+        // Do not overwrite the first error.
+        if (tim_status == TIM_SUCCESS) {
+            tim_status = tim_status_de_init;
+        }
+        TIM_exit_error(DELAY_ARBITER_ERROR_BASE_TIM);
+        goto errors;
+    }
+#endif
+    // Use LPTIM.
+    lptim_status = LPTIM_delay_milliseconds(delay_ms, delay_mode);
+    LPTIM_exit_error(DELAY_ARBITER_ERROR_BASE_LPTIM);
+errors:
+    return status;
+}
+
+#if ((defined SPSWS_WIND_RAINFALL_MEASUREMENTS) && (defined SPSWS_WIND_VANE_ULTIMETER))
+/*******************************************************************/
+void DELAY_ARBITER_set_lptim_owner(uint8_t owner_flag) {
+    delay_arbiter_lptim_owner = owner_flag;
+}
+#endif
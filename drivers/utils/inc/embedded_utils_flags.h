@@ -17,12 +17,12 @@
 #define EMBEDDED_UTILS_HW_INTERFACE_ERROR_BASE_LAST     USART_ERROR_BASE_LAST
 
 #ifdef SPSWS_MODE_CLI
-#define EMBEDDED_UTILS_AT_BAUD_RATE                     9600
+#define EMBEDDED_UTILS_AT_BAUD_RATE                     SPSWS_AT_BAUD_RATE
 #define EMBEDDED_UTILS_AT_REPLY_END                     "\r\n"
 #define EMBEDDED_UTILS_AT_FORCE_OK
 #define EMBEDDED_UTILS_AT_INTERNAL_COMMANDS_ENABLE
 #define EMBEDDED_UTILS_AT_COMMANDS_LIST_SIZE            32
-#define EMBEDDED_UTILS_AT_BUFFER_SIZE                   64
+#define EMBEDDED_UTILS_AT_BUFFER_SIZE                   80
 #ifdef EMBEDDED_UTILS_AT_INTERNAL_COMMANDS_ENABLE
 #define EMBEDDED_UTILS_AT_BOARD_NAME                    "spsws"
 #ifdef HW1_0
@@ -25,6 +25,11 @@ typedef enum {
     ANALOG_SUCCESS = 0,
     ANALOG_ERROR_NULL_PARAMETER,
     ANALOG_ERROR_CHANNEL,
+    ANALOG_ERROR_OVERSAMPLING_RATIO,
+    ANALOG_ERROR_REFERENCE_VOLTAGE,
+    ANALOG_ERROR_SCAN_TIMEOUT,
+    ANALOG_ERROR_SCAN_DATA,
+    ANALOG_ERROR_NVM,
     // Low level drivers errors.
     ANALOG_ERROR_BASE_ADC = ERROR_BASE_STEP,
     ANALOG_ERROR_BASE_MAX11136 = (ANALOG_ERROR_BASE_ADC + ADC_ERROR_BASE_LAST),
@@ -48,6 +53,49 @@ typedef enum {
     ANALOG_CHANNEL_LAST
 } ANALOG_channel_t;
 
+/*!******************************************************************
+ * \enum ANALOG_oversampling_ratio_t
+ * \brief ANALOG internal ADC software averaging ratios (log2 of the number of single conversions).
+ *******************************************************************/
+typedef enum {
+    ANALOG_OVERSAMPLING_RATIO_1 = 0,
+    ANALOG_OVERSAMPLING_RATIO_2,
+    ANALOG_OVERSAMPLING_RATIO_4,
+    ANALOG_OVERSAMPLING_RATIO_8,
+    ANALOG_OVERSAMPLING_RATIO_16,
+    ANALOG_OVERSAMPLING_RATIO_32,
+    ANALOG_OVERSAMPLING_RATIO_64,
+    ANALOG_OVERSAMPLING_RATIO_LAST
+} ANALOG_oversampling_ratio_t;
+
+/*!******************************************************************
+ * \struct ANALOG_calibration_t
+ * \brief ANALOG divider channel calibration record.
+ *******************************************************************/
+typedef struct {
+    int16_t gain_correction; // Relative gain error in 1/65536 units.
+    int16_t offset_mv;
+} ANALOG_calibration_t;
+
+/*!******************************************************************
+ * \struct ANALOG_reference_policy_t
+ * \brief ANALOG reference voltage caching policy.
+ *******************************************************************/
+typedef struct {
+    uint32_t maximum_age_seconds;
+    int32_t temperature_delta_degrees;
+} ANALOG_reference_policy_t;
+
+/*!******************************************************************
+ * \struct ANALOG_reference_statistics_t
+ * \brief ANALOG reference voltage caching statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t refresh_count;
+    uint32_t hit_count;
+    uint32_t age_seconds;
+} ANALOG_reference_statistics_t;
+
 /*** ANALOG functions ***/
 
 /*!******************************************************************
@@ -68,6 +116,35 @@ ANALOG_status_t ANALOG_init(void);
  *******************************************************************/
 ANALOG_status_t ANALOG_de_init(void);
 
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_read_calibration(void)
+ * \brief Read the divider calibration records from NVM (nominal ratio is used on failure).
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_read_calibration(void);
+
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_set_oversampling_ratio(ANALOG_channel_t channel, ANALOG_oversampling_ratio_t oversampling_ratio)
+ * \brief Set the software averaging ratio of an internal ADC channel.
+ * \param[in]   channel: Internal ADC channel to configure.
+ * \param[in]   oversampling_ratio: Number of single conversions averaged for each measurement (4^n conversions give up to n extra bits).
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_set_oversampling_ratio(ANALOG_channel_t channel, ANALOG_oversampling_ratio_t oversampling_ratio);
+
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_set_calibration(ANALOG_channel_t channel, ANALOG_calibration_t* calibration)
+ * \brief Store the production calibration of a divider channel in NVM.
+ * \param[in]   channel: Divider channel to calibrate (source or storage voltage).
+ * \param[in]   calibration: Pointer to the calibration record.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_set_calibration(ANALOG_channel_t channel, ANALOG_calibration_t* calibration);
+
 /*!******************************************************************
  * \fn ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog_data)
  * \brief Convert an analog channel.
@@ -77,6 +154,34 @@ ANALOG_status_t ANALOG_de_init(void);
  *******************************************************************/
 ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog_data);
 
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_convert_channels(ANALOG_channel_t* channels, uint8_t number_of_channels, int32_t* analog_data)
+ * \brief Convert a list of analog channels, external ADC channels being sampled in a single averaged scan.
+ * \param[in]   channels: List of channels to convert.
+ * \param[in]   number_of_channels: Number of channels in the list.
+ * \param[out]  analog_data: Pointer to the array that will contain the results, in the same order as the channels list.
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_convert_channels(ANALOG_channel_t* channels, uint8_t number_of_channels, int32_t* analog_data);
+
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_set_reference_policy(ANALOG_reference_policy_t* policy)
+ * \brief Set the reference voltage caching policy.
+ * \param[in]   policy: Pointer to the maximum age and temperature delta which trigger a new reference conversion.
+ * \param[out]  none
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_set_reference_policy(ANALOG_reference_policy_t* policy);
+
+/*!******************************************************************
+ * \fn ANALOG_status_t ANALOG_get_reference_statistics(ANALOG_reference_statistics_t* statistics)
+ * \brief Read the reference voltage caching statistics.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      Function execution status.
+ *******************************************************************/
+ANALOG_status_t ANALOG_get_reference_statistics(ANALOG_reference_statistics_t* statistics);
+
 /*******************************************************************/
 #define ANALOG_exit_error(base) { ERROR_check_exit(analog_status, ANALOG_SUCCESS, base) }
 
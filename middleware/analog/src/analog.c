@@ -11,6 +11,10 @@
 #include "error.h"
 #include "error_base.h"
 #include "max111xx.h"
+#include "max111xx_hw.h"
+#include "nvm.h"
+#include "nvm_address.h"
+#include "rtc.h"
 #include "spsws_flags.h"
 #include "types.h"
 
@@ -19,13 +23,21 @@
 #define ANALOG_MCU_VOLTAGE_DEFAULT_MV               3300
 #define ANALOG_MCU_TEMPERATURE_DEFAULT_DEGREES      25
 
+#define ANALOG_MCU_VOLTAGE_OVERSAMPLING_DEFAULT     ANALOG_OVERSAMPLING_RATIO_16
+#define ANALOG_MCU_TEMPERATURE_OVERSAMPLING_DEFAULT ANALOG_OVERSAMPLING_RATIO_4
+
 #define ANALOG_REF191_VOLTAGE_MV                    2048
+#define ANALOG_REF191_MAXIMUM_AGE_SECONDS_DEFAULT   3600
+#define ANALOG_REF191_TEMPERATURE_DELTA_DEFAULT     5
 
 #define ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_NUM     269
 #define ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_DEN     34
 #define ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_NUM    269
 #define ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_DEN    34
 
+#define ANALOG_DIVIDER_FACTOR_SHIFT                 12
+#define ANALOG_CALIBRATION_GAIN_SHIFT               16
+
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
 #define ANALOG_MAX11136_CHANNEL_WIND_DIRECTION      MAX111XX_CHANNEL_AIN0
 #endif
@@ -42,35 +54,204 @@
 #define ANALOG_MAX11136_CHANNEL_STORAGE_VOLTAGE     MAX111XX_CHANNEL_AIN7
 #endif
 
+#define ANALOG_MAX11136_NUMBER_OF_CHANNELS          8
+#define ANALOG_MAX11136_DATA_MASK                   0x0FFF
+#define ANALOG_MAX11136_CHANNEL_ID_SHIFT            12
+
+#define ANALOG_MAX11136_REGISTER_ADC_MODE_CONTROL   0x0000
+// Note: the max111xx driver never writes the configuration register, so single conversions run with its reset value.
+#define ANALOG_MAX11136_REGISTER_ADC_CONFIGURATION  0x8000
+#define ANALOG_MAX11136_REGISTER_CUSTOM_SCAN_1      0xA800
+
+#define ANALOG_MAX11136_SCAN_CUSTOM_INTERNAL        0x07
+#define ANALOG_MAX11136_SCAN_SHIFT                  11
+#define ANALOG_MAX11136_CHAN_ID                     0x0004
+#define ANALOG_MAX11136_SWCNV                       0x0002
+#define ANALOG_MAX11136_AVGON                       0x0200
+#define ANALOG_MAX11136_NAVG_SHIFT                  7
+#define ANALOG_MAX11136_CHSCAN_SHIFT                3
+
+// Averaging of each scanned channel: 0=4, 1=8, 2=16, 3=32 samples.
+#define ANALOG_MAX11136_SCAN_NAVG                   0
+#define ANALOG_MAX11136_SCAN_TIMEOUT_MS             100
+
 #define ANALOG_ERROR_VALUE                          0xFFFF
 
 /*** ANALOG local structures ***/
 
+/*******************************************************************/
+typedef enum {
+    ANALOG_DIVIDER_SOURCE_VOLTAGE = 0,
+    ANALOG_DIVIDER_STORAGE_VOLTAGE,
+    ANALOG_DIVIDER_LAST
+} ANALOG_divider_t;
+
+/*******************************************************************/
+typedef struct {
+    uint32_t ratio_numerator;
+    uint32_t ratio_denominator;
+    NVM_address_t nvm_address_calibration;
+} ANALOG_divider_descriptor_t;
+
 /*******************************************************************/
 typedef struct {
     int32_t mcu_voltage_mv;
+    int32_t mcu_temperature_degrees;
     int32_t ref191_voltage_12bits;
+    uint32_t ref191_uptime_seconds;
+    int32_t ref191_temperature_degrees;
+    ANALOG_reference_policy_t ref191_policy;
+    ANALOG_reference_statistics_t ref191_statistics;
+    ANALOG_calibration_t calibration[ANALOG_DIVIDER_LAST];
+    int32_t divider_factor[ANALOG_DIVIDER_LAST];
+    ANALOG_oversampling_ratio_t mcu_voltage_oversampling;
+    ANALOG_oversampling_ratio_t mcu_temperature_oversampling;
 } ANALOG_context_t;
 
 /*** ANALOG local global variables ***/
 
+static const ANALOG_divider_descriptor_t ANALOG_DIVIDER_DESCRIPTOR[ANALOG_DIVIDER_LAST] = {
+    { ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_NUM, ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_DEN, NVM_ADDRESS_ANALOG_CALIBRATION_SOURCE_VOLTAGE },
+    { ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_NUM, ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_DEN, NVM_ADDRESS_ANALOG_CALIBRATION_STORAGE_VOLTAGE }
+};
+
 static ANALOG_context_t analog_ctx = {
     .mcu_voltage_mv = ANALOG_MCU_VOLTAGE_DEFAULT_MV,
-    .ref191_voltage_12bits = ANALOG_ERROR_VALUE
+    .mcu_temperature_degrees = ANALOG_MCU_TEMPERATURE_DEFAULT_DEGREES,
+    .ref191_voltage_12bits = ANALOG_ERROR_VALUE,
+    .ref191_uptime_seconds = 0,
+    .ref191_temperature_degrees = ANALOG_MCU_TEMPERATURE_DEFAULT_DEGREES,
+    .ref191_policy.maximum_age_seconds = ANALOG_REF191_MAXIMUM_AGE_SECONDS_DEFAULT,
+    .ref191_policy.temperature_delta_degrees = ANALOG_REF191_TEMPERATURE_DELTA_DEFAULT,
+    .ref191_statistics.refresh_count = 0,
+    .ref191_statistics.hit_count = 0,
+    .ref191_statistics.age_seconds = 0,
+    .mcu_voltage_oversampling = ANALOG_MCU_VOLTAGE_OVERSAMPLING_DEFAULT,
+    .mcu_temperature_oversampling = ANALOG_MCU_TEMPERATURE_OVERSAMPLING_DEFAULT
 };
 
 /*** ANALOG local functions ***/
 
+/*******************************************************************/
+static ANALOG_status_t _ANALOG_convert_adc_channel(ADC_channel_t channel, ANALOG_oversampling_ratio_t oversampling_ratio, int32_t* adc_data, uint8_t* extra_bits) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    ADC_status_t adc_status = ADC_SUCCESS;
+    int32_t adc_sample_12bits = 0;
+    int32_t adc_sum = 0;
+    uint8_t shift = 0;
+    uint32_t idx = 0;
+    // Software averaging of consecutive single conversions (the ADC hardware oversampler is not used by the driver).
+    for (idx = 0; idx < (1UL << oversampling_ratio); idx++) {
+        adc_status = ADC_convert_channel(channel, &adc_sample_12bits);
+        ADC_exit_error(ANALOG_ERROR_BASE_ADC);
+        adc_sum += adc_sample_12bits;
+    }
+    // Averaging 4^n samples gives at most n extra bits, since the input noise dithers the samples: only decimate the remaining part of the sum.
+    (*extra_bits) = (uint8_t) (oversampling_ratio >> 1);
+    shift = (uint8_t) (oversampling_ratio - (*extra_bits));
+    // Decimate with rounding.
+    if (shift != 0) {
+        adc_sum += (int32_t) (1UL << (shift - 1));
+    }
+    (*adc_data) = (adc_sum >> shift);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static ANALOG_status_t _ANALOG_update_reference(int32_t ref191_voltage_12bits) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    uint32_t factor = 0;
+    uint8_t idx = 0;
+    // Check value (reference can not be lower than half of the supply voltage).
+    if ((ref191_voltage_12bits < (MAX111XX_FULL_SCALE >> 1)) || (ref191_voltage_12bits > MAX111XX_FULL_SCALE)) {
+        status = ANALOG_ERROR_REFERENCE_VOLTAGE;
+        goto errors;
+    }
+    analog_ctx.ref191_voltage_12bits = ref191_voltage_12bits;
+    analog_ctx.ref191_uptime_seconds = RTC_get_uptime_seconds();
+    analog_ctx.ref191_temperature_degrees = analog_ctx.mcu_temperature_degrees;
+    analog_ctx.ref191_statistics.refresh_count++;
+    // Precompute divider factors once per reference conversion.
+    for (idx = 0; idx < ANALOG_DIVIDER_LAST; idx++) {
+        factor = ((ANALOG_REF191_VOLTAGE_MV * ANALOG_DIVIDER_DESCRIPTOR[idx].ratio_numerator) << ANALOG_DIVIDER_FACTOR_SHIFT);
+        factor /= ((uint32_t) ref191_voltage_12bits * ANALOG_DIVIDER_DESCRIPTOR[idx].ratio_denominator);
+        // Apply gain correction.
+        analog_ctx.divider_factor[idx] = ((int32_t) factor) + ((((int32_t) factor) * ((int32_t) analog_ctx.calibration[idx].gain_correction)) >> ANALOG_CALIBRATION_GAIN_SHIFT);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static uint8_t _ANALOG_reference_is_valid(void) {
+    // Local variables.
+    uint8_t valid = 0;
+    int32_t temperature_delta = 0;
+    // Check current value.
+    if (analog_ctx.ref191_voltage_12bits == ANALOG_ERROR_VALUE) goto errors;
+    // Check age.
+    if ((RTC_get_uptime_seconds() - analog_ctx.ref191_uptime_seconds) > analog_ctx.ref191_policy.maximum_age_seconds) goto errors;
+    // Check temperature drift.
+    temperature_delta = (analog_ctx.mcu_temperature_degrees - analog_ctx.ref191_temperature_degrees);
+    if ((temperature_delta > analog_ctx.ref191_policy.temperature_delta_degrees) || (temperature_delta < (-analog_ctx.ref191_policy.temperature_delta_degrees))) goto errors;
+    // Cached value can be used.
+    valid = 1;
+errors:
+    return valid;
+}
+
+/*******************************************************************/
+static int32_t _ANALOG_compute_divider_voltage(ANALOG_divider_t divider, int32_t adc_data_12bits) {
+    // Multiply and shift only.
+    return (((adc_data_12bits * analog_ctx.divider_factor[divider]) >> ANALOG_DIVIDER_FACTOR_SHIFT) + ((int32_t) analog_ctx.calibration[divider].offset_mv));
+}
+
+/*******************************************************************/
+static ANALOG_status_t _ANALOG_get_max11136_channel(ANALOG_channel_t channel, MAX111XX_channel_t* max11136_channel) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    // Check channel.
+    switch (channel) {
+    case ANALOG_CHANNEL_SOURCE_VOLTAGE_MV:
+        (*max11136_channel) = ANALOG_MAX11136_CHANNEL_SOURCE_VOLTAGE;
+        break;
+    case ANALOG_CHANNEL_STORAGE_VOLTAGE_MV:
+        (*max11136_channel) = ANALOG_MAX11136_CHANNEL_STORAGE_VOLTAGE;
+        break;
+    case ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT:
+        (*max11136_channel) = ANALOG_MAX11136_CHANNEL_SUNSHINE_LIGHT;
+        break;
+#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
+    case ANALOG_CHANNEL_WIND_DIRECTION_RATIO_PERMILLE:
+        (*max11136_channel) = ANALOG_MAX11136_CHANNEL_WIND_DIRECTION;
+        break;
+#endif
+    default:
+        status = ANALOG_ERROR_CHANNEL;
+        break;
+    }
+    return status;
+}
+
 /*******************************************************************/
 static ANALOG_status_t _ANALOG_convert_max11136_channel(MAX111XX_channel_t channel, int32_t* adc_data_12bits) {
     // Local variables.
     ANALOG_status_t status = ANALOG_SUCCESS;
     MAX111XX_status_t max111xx_status = MAX111XX_SUCCESS;
+    int32_t ref191_voltage_12bits = 0;
     // Check current value.
-    if (analog_ctx.ref191_voltage_12bits == ANALOG_ERROR_VALUE) {
+    if (_ANALOG_reference_is_valid() == 0) {
         // Update calibration value.
-        max111xx_status = MAX111XX_convert_channel(ANALOG_MAX11136_CHANNEL_REF191, &(analog_ctx.ref191_voltage_12bits));
+        max111xx_status = MAX111XX_convert_channel(ANALOG_MAX11136_CHANNEL_REF191, &ref191_voltage_12bits);
         MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+        status = _ANALOG_update_reference(ref191_voltage_12bits);
+        if (status != ANALOG_SUCCESS) goto errors;
+    }
+    else {
+        analog_ctx.ref191_statistics.hit_count++;
     }
     max111xx_status = MAX111XX_convert_channel(channel, adc_data_12bits);
     MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
@@ -78,6 +259,114 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static ANALOG_status_t _ANALOG_scan_max11136_channels(uint8_t channels_mask, int32_t* adc_data_12bits) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    MAX111XX_status_t max111xx_status = MAX111XX_SUCCESS;
+    uint16_t tx_data = 0;
+    uint16_t rx_data = 0;
+    uint8_t number_of_channels = 0;
+    uint8_t received_mask = 0;
+    uint8_t channel = 0;
+    uint8_t eoc = 1;
+    uint8_t averaging_flag = 0;
+    uint32_t delay_ms = 0;
+    uint8_t idx = 0;
+    // Count channels.
+    for (idx = 0; idx < ANALOG_MAX11136_NUMBER_OF_CHANNELS; idx++) {
+        number_of_channels += ((channels_mask >> idx) & 0x01);
+    }
+    // Enable averaging on top of the driver configuration.
+    tx_data = ANALOG_MAX11136_REGISTER_ADC_CONFIGURATION | ANALOG_MAX11136_AVGON | (ANALOG_MAX11136_SCAN_NAVG << ANALOG_MAX11136_NAVG_SHIFT);
+    averaging_flag = 1;
+    max111xx_status = MAX111XX_HW_spi_write_read_16(&tx_data, &rx_data, 1);
+    MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+    // Select channels.
+    tx_data = ANALOG_MAX11136_REGISTER_CUSTOM_SCAN_1 | (channels_mask << ANALOG_MAX11136_CHSCAN_SHIFT);
+    max111xx_status = MAX111XX_HW_spi_write_read_16(&tx_data, &rx_data, 1);
+    MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+    // Start custom scan with internal clock.
+    tx_data = ANALOG_MAX11136_REGISTER_ADC_MODE_CONTROL | (ANALOG_MAX11136_SCAN_CUSTOM_INTERNAL << ANALOG_MAX11136_SCAN_SHIFT) | ANALOG_MAX11136_CHAN_ID | ANALOG_MAX11136_SWCNV;
+    max111xx_status = MAX111XX_HW_spi_write_read_16(&tx_data, &rx_data, 1);
+    MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+    // Wait for end of scan.
+    while (1) {
+        max111xx_status = MAX111XX_HW_gpio_read_eoc(&eoc);
+        MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+        if (eoc == 0) break;
+        // Exit if timeout.
+        if (delay_ms >= ANALOG_MAX11136_SCAN_TIMEOUT_MS) {
+            status = ANALOG_ERROR_SCAN_TIMEOUT;
+            goto errors;
+        }
+        max111xx_status = MAX111XX_HW_delay_milliseconds(1);
+        MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+        delay_ms++;
+    }
+    // Read FIFO.
+    tx_data = ANALOG_MAX11136_REGISTER_ADC_MODE_CONTROL;
+    for (idx = 0; idx < number_of_channels; idx++) {
+        max111xx_status = MAX111XX_HW_spi_write_read_16(&tx_data, &rx_data, 1);
+        MAX111XX_exit_error(ANALOG_ERROR_BASE_MAX11136);
+        // Check channel ID.
+        channel = (uint8_t) (rx_data >> ANALOG_MAX11136_CHANNEL_ID_SHIFT);
+        if ((channel >= ANALOG_MAX11136_NUMBER_OF_CHANNELS) || (((channels_mask >> channel) & 0x01) == 0)) {
+            status = ANALOG_ERROR_SCAN_DATA;
+            goto errors;
+        }
+        adc_data_12bits[channel] = (int32_t) (rx_data & ANALOG_MAX11136_DATA_MASK);
+        received_mask |= (uint8_t) (0x01 << channel);
+    }
+    // Check that all selected channels have been read.
+    if (received_mask != channels_mask) {
+        status = ANALOG_ERROR_SCAN_DATA;
+        goto errors;
+    }
+errors:
+    // Restore driver configuration for single conversions.
+    if (averaging_flag != 0) {
+        tx_data = ANALOG_MAX11136_REGISTER_ADC_CONFIGURATION;
+        max111xx_status = MAX111XX_HW_spi_write_read_16(&tx_data, &rx_data, 1);
+        // Do not overwrite the first error.
+        if ((max111xx_status != MAX111XX_SUCCESS) && (status == ANALOG_SUCCESS)) {
+            status = (ANALOG_ERROR_BASE_MAX11136 + max111xx_status);
+        }
+    }
+    return status;
+}
+
+/*******************************************************************/
+static ANALOG_status_t _ANALOG_compute_max11136_channel(ANALOG_channel_t channel, int32_t adc_data_12bits, int32_t* analog_data) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    // Check channel.
+    switch (channel) {
+    case ANALOG_CHANNEL_SOURCE_VOLTAGE_MV:
+        // Convert to mV.
+        (*analog_data) = _ANALOG_compute_divider_voltage(ANALOG_DIVIDER_SOURCE_VOLTAGE, adc_data_12bits);
+        break;
+    case ANALOG_CHANNEL_STORAGE_VOLTAGE_MV:
+        // Convert to mV.
+        (*analog_data) = _ANALOG_compute_divider_voltage(ANALOG_DIVIDER_STORAGE_VOLTAGE, adc_data_12bits);
+        break;
+    case ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT:
+        // Convert to percent.
+        (*analog_data) = (adc_data_12bits * 100) / (MAX111XX_FULL_SCALE);
+        break;
+#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
+    case ANALOG_CHANNEL_WIND_DIRECTION_RATIO_PERMILLE:
+        // Convert to ratio.
+        (*analog_data) = (adc_data_12bits * 1000) / (MAX111XX_FULL_SCALE);
+        break;
+#endif
+    default:
+        status = ANALOG_ERROR_CHANNEL;
+        break;
+    }
+    return status;
+}
+
 /*** ANALOG functions ***/
 
 /*******************************************************************/
@@ -88,7 +377,7 @@ ANALOG_status_t ANALOG_init(void) {
     MAX111XX_status_t max111xx_status = MAX111XX_SUCCESS;
     // Init context.
     analog_ctx.mcu_voltage_mv = ANALOG_MCU_VOLTAGE_DEFAULT_MV;
-    analog_ctx.ref191_voltage_12bits = ANALOG_ERROR_VALUE;
+    // Note: production calibration is read once at boot by ANALOG_read_calibration().
     // Init internal ADC.
     adc_status = ADC_init(NULL);
     ADC_exit_error(ANALOG_ERROR_BASE_ADC);
@@ -105,8 +394,7 @@ ANALOG_status_t ANALOG_de_init(void) {
     ANALOG_status_t status = ANALOG_SUCCESS;
     ADC_status_t adc_status = ADC_SUCCESS;
     MAX111XX_status_t max111xx_status = MAX111XX_SUCCESS;
-    // Erase calibration value.
-    analog_ctx.ref191_voltage_12bits = ANALOG_ERROR_VALUE;
+    // Note: reference value is kept and refreshed according to the caching policy.
     // Release internal ADC.
     adc_status = ADC_de_init();
     ADC_stack_error(ERROR_BASE_ANALOG + ANALOG_ERROR_BASE_ADC);
@@ -116,12 +404,123 @@ ANALOG_status_t ANALOG_de_init(void) {
     return status;
 }
 
+/*******************************************************************/
+ANALOG_status_t ANALOG_read_calibration(void) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    ANALOG_calibration_t calibration[ANALOG_DIVIDER_LAST];
+    uint8_t nvm_bytes[4];
+    uint8_t idx = 0;
+    uint8_t byte_idx = 0;
+    // Use nominal ratio by default.
+    for (idx = 0; idx < ANALOG_DIVIDER_LAST; idx++) {
+        analog_ctx.calibration[idx].gain_correction = 0;
+        analog_ctx.calibration[idx].offset_mv = 0;
+    }
+    // Read calibration records.
+    for (idx = 0; idx < ANALOG_DIVIDER_LAST; idx++) {
+        for (byte_idx = 0; byte_idx < sizeof(nvm_bytes); byte_idx++) {
+            nvm_status = NVM_read_byte((ANALOG_DIVIDER_DESCRIPTOR[idx].nvm_address_calibration + byte_idx), &(nvm_bytes[byte_idx]));
+            // Note: NVM errors are stacked with the board base to keep the ANALOG error range unchanged.
+            NVM_stack_error(ERROR_BASE_NVM);
+            if (nvm_status != NVM_SUCCESS) {
+                status = ANALOG_ERROR_NVM;
+                goto errors;
+            }
+        }
+        calibration[idx].gain_correction = (int16_t) ((((uint16_t) nvm_bytes[0]) << 8) | ((uint16_t) nvm_bytes[1]));
+        calibration[idx].offset_mv = (int16_t) ((((uint16_t) nvm_bytes[2]) << 8) | ((uint16_t) nvm_bytes[3]));
+    }
+    // Apply records only when all of them have been read.
+    for (idx = 0; idx < ANALOG_DIVIDER_LAST; idx++) {
+        analog_ctx.calibration[idx] = calibration[idx];
+    }
+    // Force factors update on next conversion.
+    analog_ctx.ref191_voltage_12bits = ANALOG_ERROR_VALUE;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_set_oversampling_ratio(ANALOG_channel_t channel, ANALOG_oversampling_ratio_t oversampling_ratio) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    // Check parameter.
+    if (oversampling_ratio >= ANALOG_OVERSAMPLING_RATIO_LAST) {
+        status = ANALOG_ERROR_OVERSAMPLING_RATIO;
+        goto errors;
+    }
+    // Check channel.
+    switch (channel) {
+    case ANALOG_CHANNEL_MCU_VOLTAGE_MV:
+        analog_ctx.mcu_voltage_oversampling = oversampling_ratio;
+        break;
+    case ANALOG_CHANNEL_MCU_TEMPERATURE_DEGREES:
+        analog_ctx.mcu_temperature_oversampling = oversampling_ratio;
+        break;
+    default:
+        status = ANALOG_ERROR_CHANNEL;
+        goto errors;
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_set_calibration(ANALOG_channel_t channel, ANALOG_calibration_t* calibration) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    ANALOG_divider_t divider = ANALOG_DIVIDER_LAST;
+    uint8_t nvm_bytes[4];
+    uint8_t idx = 0;
+    // Check parameter.
+    if (calibration == NULL) {
+        status = ANALOG_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Check channel.
+    switch (channel) {
+    case ANALOG_CHANNEL_SOURCE_VOLTAGE_MV:
+        divider = ANALOG_DIVIDER_SOURCE_VOLTAGE;
+        break;
+    case ANALOG_CHANNEL_STORAGE_VOLTAGE_MV:
+        divider = ANALOG_DIVIDER_STORAGE_VOLTAGE;
+        break;
+    default:
+        status = ANALOG_ERROR_CHANNEL;
+        goto errors;
+    }
+    // Write record.
+    nvm_bytes[0] = (uint8_t) (((uint16_t) (calibration->gain_correction)) >> 8);
+    nvm_bytes[1] = (uint8_t) (((uint16_t) (calibration->gain_correction)) >> 0);
+    nvm_bytes[2] = (uint8_t) (((uint16_t) (calibration->offset_mv)) >> 8);
+    nvm_bytes[3] = (uint8_t) (((uint16_t) (calibration->offset_mv)) >> 0);
+    for (idx = 0; idx < sizeof(nvm_bytes); idx++) {
+        nvm_status = NVM_write_byte((ANALOG_DIVIDER_DESCRIPTOR[divider].nvm_address_calibration + idx), nvm_bytes[idx]);
+        NVM_stack_error(ERROR_BASE_NVM);
+        if (nvm_status != NVM_SUCCESS) {
+            status = ANALOG_ERROR_NVM;
+            goto errors;
+        }
+    }
+    // Update context.
+    analog_ctx.calibration[divider] = (*calibration);
+    // Force factors update on next conversion.
+    analog_ctx.ref191_voltage_12bits = ANALOG_ERROR_VALUE;
+errors:
+    return status;
+}
+
 /*******************************************************************/
 ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog_data) {
     // Local variables.
     ANALOG_status_t status = ANALOG_SUCCESS;
     ADC_status_t adc_status = ADC_SUCCESS;
+    MAX111XX_channel_t max11136_channel = MAX111XX_CHANNEL_AIN0;
     int32_t adc_data_12bits = 0;
+    uint8_t extra_bits = 0;
     // Check parameter.
     if (analog_data == NULL) {
         status = ANALOG_ERROR_NULL_PARAMETER;
@@ -131,56 +530,125 @@ ANALOG_status_t ANALOG_convert_channel(ANALOG_channel_t channel, int32_t* analog
     switch (channel) {
     case ANALOG_CHANNEL_MCU_VOLTAGE_MV:
         // MCU voltage.
-        adc_status = ADC_convert_channel(ADC_CHANNEL_VREFINT, &adc_data_12bits);
-        ADC_exit_error(ANALOG_ERROR_BASE_ADC);
-        // Convert to mV.
-        adc_status = ADC_compute_mcu_voltage(adc_data_12bits, ADC_get_vrefint_voltage_mv(), analog_data);
+        status = _ANALOG_convert_adc_channel(ADC_CHANNEL_VREFINT, analog_ctx.mcu_voltage_oversampling, &adc_data_12bits, &extra_bits);
+        if (status != ANALOG_SUCCESS) goto errors;
+        // Convert to mV (ratiometric formula: scaling the reference by the extra bits keeps the full resolution).
+        adc_status = ADC_compute_mcu_voltage(adc_data_12bits, (ADC_get_vrefint_voltage_mv() << extra_bits), analog_data);
         ADC_exit_error(ANALOG_ERROR_BASE_ADC);
         // Update local value for temperature computation.
         analog_ctx.mcu_voltage_mv = (*analog_data);
         break;
     case ANALOG_CHANNEL_MCU_TEMPERATURE_DEGREES:
         // MCU temperature.
-        adc_status = ADC_convert_channel(ADC_CHANNEL_TEMPERATURE_SENSOR, &adc_data_12bits);
-        ADC_exit_error(ANALOG_ERROR_BASE_ADC);
+        status = _ANALOG_convert_adc_channel(ADC_CHANNEL_TEMPERATURE_SENSOR, analog_ctx.mcu_temperature_oversampling, &adc_data_12bits, &extra_bits);
+        if (status != ANALOG_SUCCESS) goto errors;
+        // Temperature is computed in whole degrees: extra bits are only used to round the averaged sample.
+        if (extra_bits != 0) {
+            adc_data_12bits = ((adc_data_12bits + (int32_t) (1UL << (extra_bits - 1))) >> extra_bits);
+        }
         // Convert to degrees.
         adc_status = ADC_compute_mcu_temperature(analog_ctx.mcu_voltage_mv, adc_data_12bits, analog_data);
         ADC_exit_error(ANALOG_ERROR_BASE_ADC);
+        // Update local value for reference drift check.
+        analog_ctx.mcu_temperature_degrees = (*analog_data);
         break;
-    case ANALOG_CHANNEL_SOURCE_VOLTAGE_MV:
-        // Solar cell voltage.
-        status = _ANALOG_convert_max11136_channel(ANALOG_MAX11136_CHANNEL_SOURCE_VOLTAGE, &adc_data_12bits);
+    default:
+        // External ADC channels.
+        status = _ANALOG_get_max11136_channel(channel, &max11136_channel);
         if (status != ANALOG_SUCCESS) goto errors;
-        // Convert to mV.
-        (*analog_data) = (adc_data_12bits * ANALOG_REF191_VOLTAGE_MV * ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_NUM) / (analog_ctx.ref191_voltage_12bits * ANALOG_DIVIDER_RATIO_SOURCE_VOLTAGE_DEN);
-        break;
-    case ANALOG_CHANNEL_STORAGE_VOLTAGE_MV:
-        // Supercap voltage.
-        status = _ANALOG_convert_max11136_channel(ANALOG_MAX11136_CHANNEL_STORAGE_VOLTAGE, &adc_data_12bits);
+        status = _ANALOG_convert_max11136_channel(max11136_channel, &adc_data_12bits);
         if (status != ANALOG_SUCCESS) goto errors;
-        // Convert to mV.
-        (*analog_data) = (adc_data_12bits * ANALOG_REF191_VOLTAGE_MV * ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_NUM) / (analog_ctx.ref191_voltage_12bits * ANALOG_DIVIDER_RATIO_STORAGE_VOLTAGE_DEN);
-        break;
-    case ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT:
-        // Light sensor.
-        status = _ANALOG_convert_max11136_channel(ANALOG_MAX11136_CHANNEL_SUNSHINE_LIGHT, &adc_data_12bits);
+        // Convert to physical value.
+        status = _ANALOG_compute_max11136_channel(channel, adc_data_12bits, analog_data);
         if (status != ANALOG_SUCCESS) goto errors;
-        // Convert to percent.
-        (*analog_data) = (adc_data_12bits * 100) / (MAX111XX_FULL_SCALE);
         break;
-#ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
-    case ANALOG_CHANNEL_WIND_DIRECTION_RATIO_PERMILLE:
-        // Wind vane direction.
-        status = _ANALOG_convert_max11136_channel(ANALOG_MAX11136_CHANNEL_WIND_DIRECTION, &adc_data_12bits);
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_convert_channels(ANALOG_channel_t* channels, uint8_t number_of_channels, int32_t* analog_data) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    MAX111XX_channel_t max11136_channel = MAX111XX_CHANNEL_AIN0;
+    int32_t adc_data_12bits[ANALOG_MAX11136_NUMBER_OF_CHANNELS];
+    uint8_t channels_mask = 0;
+    uint8_t idx = 0;
+    // Check parameters.
+    if ((channels == NULL) || (analog_data == NULL)) {
+        status = ANALOG_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Reset data.
+    for (idx = 0; idx < ANALOG_MAX11136_NUMBER_OF_CHANNELS; idx++) {
+        adc_data_12bits[idx] = ANALOG_ERROR_VALUE;
+    }
+    // Convert internal channels and build external scan list.
+    for (idx = 0; idx < number_of_channels; idx++) {
+        if (_ANALOG_get_max11136_channel(channels[idx], &max11136_channel) == ANALOG_SUCCESS) {
+            channels_mask |= (uint8_t) (0x01 << max11136_channel);
+        }
+        else {
+            status = ANALOG_convert_channel(channels[idx], &(analog_data[idx]));
+            if (status != ANALOG_SUCCESS) goto errors;
+        }
+    }
+    // Directly exit if there is no external channel.
+    if (channels_mask == 0) goto errors;
+    // Add reference to the scan if required.
+    if (_ANALOG_reference_is_valid() == 0) {
+        channels_mask |= (uint8_t) (0x01 << ANALOG_MAX11136_CHANNEL_REF191);
+    }
+    else {
+        analog_ctx.ref191_statistics.hit_count++;
+    }
+    // Convert all external channels in a single scan.
+    status = _ANALOG_scan_max11136_channels(channels_mask, adc_data_12bits);
+    if (status != ANALOG_SUCCESS) goto errors;
+    // Update calibration value.
+    if ((channels_mask & (0x01 << ANALOG_MAX11136_CHANNEL_REF191)) != 0) {
+        status = _ANALOG_update_reference(adc_data_12bits[ANALOG_MAX11136_CHANNEL_REF191]);
         if (status != ANALOG_SUCCESS) goto errors;
-        // Convert to ratio.
-        (*analog_data) = (adc_data_12bits * 1000) / (MAX111XX_FULL_SCALE);
-        break;
-#endif
-    default:
-        status = ANALOG_ERROR_CHANNEL;
+    }
+    // Convert to physical values.
+    for (idx = 0; idx < number_of_channels; idx++) {
+        if (_ANALOG_get_max11136_channel(channels[idx], &max11136_channel) == ANALOG_SUCCESS) {
+            status = _ANALOG_compute_max11136_channel(channels[idx], adc_data_12bits[max11136_channel], &(analog_data[idx]));
+            if (status != ANALOG_SUCCESS) goto errors;
+        }
+    }
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_set_reference_policy(ANALOG_reference_policy_t* policy) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    // Check parameter.
+    if (policy == NULL) {
+        status = ANALOG_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Update policy.
+    analog_ctx.ref191_policy = (*policy);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+ANALOG_status_t ANALOG_get_reference_statistics(ANALOG_reference_statistics_t* statistics) {
+    // Local variables.
+    ANALOG_status_t status = ANALOG_SUCCESS;
+    // Check parameter.
+    if (statistics == NULL) {
+        status = ANALOG_ERROR_NULL_PARAMETER;
         goto errors;
     }
+    // Copy statistics.
+    (*statistics) = analog_ctx.ref191_statistics;
+    statistics->age_seconds = (analog_ctx.ref191_voltage_12bits == ANALOG_ERROR_VALUE) ? 0 : (RTC_get_uptime_seconds() - analog_ctx.ref191_uptime_seconds);
 errors:
     return status;
 }
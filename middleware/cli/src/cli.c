@@ -22,6 +22,7 @@
 #include "maths.h"
 #include "parser.h"
 #include "strings.h"
+#include "terminal_hw.h"
 #include "terminal_instance.h"
 #include "types.h"
 // Components.
@@ -39,6 +40,9 @@
 #include "sigfox_ep_addon_rfp_api.h"
 #include "sigfox_ep_api.h"
 #include "sigfox_ep_flags.h"
+#ifdef SPSWS_PROFILING
+#include "sigfox_ep_frames.h"
+#endif
 #include "sigfox_error.h"
 #include "sigfox_rc.h"
 #include "sigfox_types.h"
@@ -53,14 +57,48 @@
 
 #define CLI_CHAR_SEPARATOR              STRING_CHAR_COMMA
 #define CLI_RSSI_REPORT_PERIOD_MS       500
+#define CLI_SWEEP_POINTS_PER_LINE       12
+#define CLI_SWEEP_FREQUENCY_MIN_HZ      863000000
+#define CLI_SWEEP_FREQUENCY_MAX_HZ      870000000
+#define CLI_SWEEP_POINTS_MAX            1024
+#define CLI_SWEEP_DWELL_MS_MAX          1000
+#define CLI_SWEEP_DURATION_MS_MAX       600000
 #define CLI_TEMPERATURE_STRING_SIZE     5
 
+// Note: library data is updated by the Sigfox library after provisioning, so it is not included in the digest.
+#define CLI_PROVISIONING_BLOCK_SIZE     (SIGFOX_EP_ID_SIZE_BYTES + SIGFOX_EP_KEY_SIZE_BYTES)
+#define CLI_CRC16_POLYNOMIAL            0x1021
+#define CLI_CRC16_INIT                  0xFFFF
+
+#define CLI_STREAM_VALUES_SIZE_MAX      10
+#define CLI_STREAM_ERROR_VALUE          0x7FFFFFFF
+#define CLI_STREAM_BINARY_SYNC_BYTE     0xA5
+#define CLI_STREAM_BINARY_HEADER_SIZE   7
+#define CLI_STREAM_BINARY_SIZE_MAX      (CLI_STREAM_BINARY_HEADER_SIZE + (4 * CLI_STREAM_VALUES_SIZE_MAX) + 2)
+// Note: the watchdog is only reloaded between records.
+#define CLI_STREAM_DELAY_MS_MAX         10000
+#define CLI_STREAM_I2C_DOMAINS_MASK     ((0b1 << CLI_STREAM_DOMAIN_SHT30_INTERNAL) | (0b1 << CLI_STREAM_DOMAIN_SHT30_EXTERNAL) | (0b1 << CLI_STREAM_DOMAIN_DPS310) | (0b1 << CLI_STREAM_DOMAIN_SI1133))
+
 /*** CLI local structures ***/
 
+/*******************************************************************/
+typedef enum {
+    CLI_STREAM_DOMAIN_ANALOG = 0,
+    CLI_STREAM_DOMAIN_SHT30_INTERNAL,
+    CLI_STREAM_DOMAIN_SHT30_EXTERNAL,
+    CLI_STREAM_DOMAIN_DPS310,
+    CLI_STREAM_DOMAIN_SI1133,
+    CLI_STREAM_DOMAIN_LAST
+} CLI_stream_domain_t;
+
 /*******************************************************************/
 typedef struct {
     volatile uint8_t at_process_flag;
     PARSER_context_t* at_parser_ptr;
+    uint8_t stream_mask;
+    uint8_t stream_binary_format;
+    uint32_t stream_delay_ms;
+    uint32_t stream_record_count;
 } CLI_context_t;
 
 /*** CLI local functions declaration ***/
@@ -71,15 +109,27 @@ static AT_status_t _CLI_get_ep_id_callback(void);
 static AT_status_t _CLI_set_ep_id_callback(void);
 static AT_status_t _CLI_get_ep_key_callback(void);
 static AT_status_t _CLI_set_ep_key_callback(void);
+static AT_status_t _CLI_get_provisioning_callback(void);
+static AT_status_t _CLI_set_provisioning_callback(void);
+#ifdef SPSWS_PROFILING
+static AT_status_t _CLI_get_profiling_callback(void);
+#endif
 static AT_status_t _CLI_adc_callback(void);
+static AT_status_t _CLI_acal_callback(void);
+static AT_status_t _CLI_aovs_callback(void);
+static AT_status_t _CLI_aref_callback(void);
+static AT_status_t _CLI_set_aref_callback(void);
 static AT_status_t _CLI_iths_callback(void);
 #ifdef HW2_0
 static AT_status_t _CLI_eths_callback(void);
 #endif
 static AT_status_t _CLI_epts_callback(void);
 static AT_status_t _CLI_euvs_callback(void);
+static AT_status_t _CLI_stream_callback(void);
 static AT_status_t _CLI_time_callback(void);
 static AT_status_t _CLI_gps_callback(void);
+static AT_status_t _CLI_gpss_callback(void);
+static AT_status_t _CLI_gpsr_callback(void);
 #ifdef SIGFOX_EP_CONTROL_KEEP_ALIVE_MESSAGE
 static AT_status_t _CLI_so_callback(void);
 #endif
@@ -89,6 +139,7 @@ static AT_status_t _CLI_tm_callback(void);
 static AT_status_t _CLI_cw_callback(void);
 #ifdef SIGFOX_EP_BIDIRECTIONAL
 static AT_status_t _CLI_rssi_callback(void);
+static AT_status_t _CLI_sweep_callback(void);
 #endif
 
 /*** CLI local global variables ***/
@@ -130,12 +181,56 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
         .description = "Set Sigfox EP key",
         .callback = &_CLI_set_ep_key_callback
     },
+    {
+        .syntax = "$PROV?",
+        .parameters = NULL,
+        .description = "Get Sigfox EP ID and key CRC and status",
+        .callback = &_CLI_get_provisioning_callback
+    },
+    {
+        .syntax = "$PROV=",
+        .parameters = "<id[hex]>,<key[hex]>,(<lib_data[hex]>)",
+        .description = "Write Sigfox EP ID, key and library data in a single block",
+        .callback = &_CLI_set_provisioning_callback
+    },
+#ifdef SPSWS_PROFILING
+    {
+        .syntax = "$PROF?",
+        .parameters = NULL,
+        .description = "Read last state machine profiling period",
+        .callback = &_CLI_get_profiling_callback
+    },
+#endif
     {
         .syntax = "$ADC?",
         .parameters = NULL,
         .description = "Read analog measurements",
         .callback = &_CLI_adc_callback
     },
+    {
+        .syntax = "$ACAL=",
+        .parameters = "<channel[dec]>,<gain_correction[dec]>,<offset[mv]>",
+        .description = "Set analog divider calibration (channel 0=source 1=storage, gain in 1/65536)",
+        .callback = &_CLI_acal_callback
+    },
+    {
+        .syntax = "$AOVS=",
+        .parameters = "<channel[dec]>,<ratio_log2[dec]>",
+        .description = "Set internal ADC software averaging (channel 0=MCU voltage 1=MCU temperature, log2 of samples 0 to 6)",
+        .callback = &_CLI_aovs_callback
+    },
+    {
+        .syntax = "$AREF?",
+        .parameters = NULL,
+        .description = "Get analog reference caching statistics",
+        .callback = &_CLI_aref_callback
+    },
+    {
+        .syntax = "$AREF=",
+        .parameters = "<maximum_age[s]>,<temperature_delta[degrees]>",
+        .description = "Set analog reference caching policy",
+        .callback = &_CLI_set_aref_callback
+    },
     {
         .syntax = "$ITHS?",
         .parameters = NULL,
@@ -162,6 +257,12 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
         .description = "Read UV index",
         .callback = &_CLI_euvs_callback
     },
+    {
+        .syntax = "$STREAM=",
+        .parameters = "<domains_mask[hex]>,(<delay[ms]>,<binary_format[bit]>)",
+        .description = "Start sensors streaming (bit0=analog 1=iths 2=eths 3=epts 4=euvs, delay 10s max) or stop it with mask 0",
+        .callback = &_CLI_stream_callback
+    },
     {
         .syntax = "$TIME=",
         .parameters = "<timeout[s]>",
@@ -174,6 +275,18 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
         .description = "Get GPS position",
         .callback = &_CLI_gps_callback
     },
+    {
+        .syntax = "$GPSS?",
+        .parameters = NULL,
+        .description = "Get GPS processing statistics",
+        .callback = &_CLI_gpss_callback
+    },
+    {
+        .syntax = "$GPSR",
+        .parameters = NULL,
+        .description = "Reset GPS processing statistics",
+        .callback = &_CLI_gpsr_callback
+    },
 #ifdef SIGFOX_EP_CONTROL_KEEP_ALIVE_MESSAGE
     {
         .syntax = "$SO",
@@ -212,13 +325,23 @@ static const AT_command_t CLI_COMMANDS_LIST[] = {
         .parameters = "<frequency[hz]>,<duration[s]>",
         .description = "Continuous RSSI measurement",
         .callback = &_CLI_rssi_callback
+    },
+    {
+        .syntax = "$SWEEP=",
+        .parameters = "<start_frequency[hz]>,<stop_frequency[hz]>,<step[hz]>,<dwell[ms]>,<sweep_count[dec]>",
+        .description = "RSSI spectrum sweep in the 863-870MHz band (10 minutes max)",
+        .callback = &_CLI_sweep_callback
     }
 #endif
 };
 
 static CLI_context_t cli_ctx = {
     .at_process_flag = 0,
-    .at_parser_ptr = NULL
+    .at_parser_ptr = NULL,
+    .stream_mask = 0,
+    .stream_binary_format = 0,
+    .stream_delay_ms = 0,
+    .stream_record_count = 0
 };
 
 /*** CLI local functions ***/
@@ -362,6 +485,192 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static uint16_t _CLI_compute_crc16(uint8_t* data, uint8_t data_size_bytes) {
+    // Local variables.
+    uint16_t crc = CLI_CRC16_INIT;
+    uint8_t idx = 0;
+    uint8_t bit_idx = 0;
+    // Bytes loop.
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        crc ^= (uint16_t) (((uint16_t) data[idx]) << 8);
+        for (bit_idx = 0; bit_idx < 8; bit_idx++) {
+            crc = ((crc & 0x8000) != 0) ? ((uint16_t) ((crc << 1) ^ CLI_CRC16_POLYNOMIAL)) : ((uint16_t) (crc << 1));
+        }
+    }
+    return crc;
+}
+
+/*******************************************************************/
+static NVM_status_t _CLI_read_provisioning_block(uint8_t* provisioning_block) {
+    // Local variables.
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t idx = 0;
+    // ID and key are contiguous in NVM.
+    for (idx = 0; idx < CLI_PROVISIONING_BLOCK_SIZE; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_ID + idx), &(provisioning_block[idx]));
+        if (nvm_status != NVM_SUCCESS) break;
+    }
+    return nvm_status;
+}
+
+/*******************************************************************/
+static NVM_status_t _CLI_write_provisioning_bytes(NVM_address_t address, uint8_t* data, uint8_t data_size_bytes) {
+    // Local variables.
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t nvm_byte = 0;
+    uint8_t idx = 0;
+    // Unchanged bytes are skipped to save EEPROM programming time.
+    for (idx = 0; idx < data_size_bytes; idx++) {
+        nvm_status = NVM_read_byte((address + idx), &nvm_byte);
+        if (nvm_status != NVM_SUCCESS) break;
+        if (nvm_byte != data[idx]) {
+            nvm_status = NVM_write_byte((address + idx), data[idx]);
+            if (nvm_status != NVM_SUCCESS) break;
+        }
+    }
+    return nvm_status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_get_provisioning_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t provisioning_block[CLI_PROVISIONING_BLOCK_SIZE];
+    uint8_t crc_msb = 0;
+    uint8_t crc_lsb = 0;
+    uint16_t crc = 0;
+    // Compute current block CRC.
+    nvm_status = _CLI_read_provisioning_block(provisioning_block);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    crc = _CLI_compute_crc16(provisioning_block, CLI_PROVISIONING_BLOCK_SIZE);
+    // Read CRC stored during provisioning.
+    nvm_status = NVM_read_byte(NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC, &crc_msb);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC + 1), &crc_lsb);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    // Print digest.
+    AT_reply_add_integer((int32_t) crc, STRING_FORMAT_HEXADECIMAL, 0);
+    AT_reply_add_string((crc == ((((uint16_t) crc_msb) << 8) + ((uint16_t) crc_lsb))) ? ":VALID" : ":INVALID");
+    AT_send_reply();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_set_provisioning_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    uint8_t provisioning_block[CLI_PROVISIONING_BLOCK_SIZE];
+    uint8_t lib_data[SIGFOX_NVM_DATA_SIZE_BYTES];
+    uint8_t lib_data_flag = 0;
+    uint8_t nvm_byte = 0;
+    uint16_t crc = 0;
+    uint32_t unused = 0;
+    uint8_t idx = 0;
+    // Read ID parameter.
+    parser_status = PARSER_get_byte_array(cli_ctx.at_parser_ptr, CLI_CHAR_SEPARATOR, SIGFOX_EP_ID_SIZE_BYTES, 1, &(provisioning_block[0]), &unused);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // First try with library data.
+    parser_status = PARSER_get_byte_array(cli_ctx.at_parser_ptr, CLI_CHAR_SEPARATOR, SIGFOX_EP_KEY_SIZE_BYTES, 1, &(provisioning_block[SIGFOX_EP_ID_SIZE_BYTES]), &unused);
+    if (parser_status == PARSER_SUCCESS) {
+        // Read library data parameter.
+        parser_status = PARSER_get_byte_array(cli_ctx.at_parser_ptr, STRING_CHAR_NULL, SIGFOX_NVM_DATA_SIZE_BYTES, 1, lib_data, &unused);
+        PARSER_exit_error(AT_ERROR_BASE_PARSER);
+        lib_data_flag = 1;
+    }
+    else {
+        // Try with key only.
+        parser_status = PARSER_get_byte_array(cli_ctx.at_parser_ptr, STRING_CHAR_NULL, SIGFOX_EP_KEY_SIZE_BYTES, 1, &(provisioning_block[SIGFOX_EP_ID_SIZE_BYTES]), &unused);
+        PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    }
+    crc = _CLI_compute_crc16(provisioning_block, CLI_PROVISIONING_BLOCK_SIZE);
+    // Write ID and key.
+    nvm_status = _CLI_write_provisioning_bytes(NVM_ADDRESS_SIGFOX_EP_ID, provisioning_block, CLI_PROVISIONING_BLOCK_SIZE);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    // Write initial library data only if given, to keep the current sequence number otherwise.
+    if (lib_data_flag != 0) {
+        nvm_status = _CLI_write_provisioning_bytes(NVM_ADDRESS_SIGFOX_EP_LIB_DATA, lib_data, SIGFOX_NVM_DATA_SIZE_BYTES);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    }
+    // Store CRC.
+    nvm_status = NVM_write_byte(NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC, (uint8_t) (crc >> 8));
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    nvm_status = NVM_write_byte((NVM_ADDRESS_SIGFOX_EP_PROVISIONING_CRC + 1), (uint8_t) (crc >> 0));
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    // Read back and check block.
+    nvm_status = _CLI_read_provisioning_block(provisioning_block);
+    _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    if (_CLI_compute_crc16(provisioning_block, CLI_PROVISIONING_BLOCK_SIZE) != crc) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    for (idx = 0; (lib_data_flag != 0) && (idx < SIGFOX_NVM_DATA_SIZE_BYTES); idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_SIGFOX_EP_LIB_DATA + idx), &nvm_byte);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+        if (nvm_byte != lib_data[idx]) {
+            status = AT_ERROR_COMMAND_EXECUTION;
+            goto errors;
+        }
+    }
+    // Print digest.
+    AT_reply_add_integer((int32_t) crc, STRING_FORMAT_HEXADECIMAL, 0);
+    AT_send_reply();
+errors:
+    return status;
+}
+
+#ifdef SPSWS_PROFILING
+/*******************************************************************/
+static AT_status_t _CLI_get_profiling_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    NVM_status_t nvm_status = NVM_SUCCESS;
+    SIGFOX_EP_ul_payload_profiling_t profiling;
+    uint8_t nvm_byte = 0;
+    uint32_t wake_up_count = 0;
+    uint8_t idx = 0;
+    // Read last period stored by the application.
+    for (idx = 0; idx < SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_PROFILING_FRAME + idx), &(profiling.frame[idx]));
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+    }
+    // Print frame fields.
+    AT_reply_add_string("awake=");
+    AT_reply_add_integer((int32_t) profiling.awake_seconds, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("s");
+    AT_send_reply();
+    AT_reply_add_string("dominant_state=");
+    AT_reply_add_integer((int32_t) profiling.dominant_state, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(" total=");
+    AT_reply_add_integer((int32_t) profiling.dominant_state_seconds, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("s max=");
+    AT_reply_add_integer((int32_t) profiling.dominant_state_max_seconds, STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("s");
+    AT_send_reply();
+    AT_reply_add_string("filtered_wake_up_count_log2=");
+    AT_reply_add_integer((int32_t) profiling.filtered_wake_up_count_log2, STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+    // Print sleep wake-up sources (RTC then external interrupts).
+    for (idx = 0; idx < 2; idx++) {
+        nvm_status = NVM_read_byte((NVM_ADDRESS_PROFILING_WAKE_UP_COUNT + (idx << 1) + 0), &nvm_byte);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+        wake_up_count = (((uint32_t) nvm_byte) << 8);
+        nvm_status = NVM_read_byte((NVM_ADDRESS_PROFILING_WAKE_UP_COUNT + (idx << 1) + 1), &nvm_byte);
+        _CLI_check_driver_status(nvm_status, NVM_SUCCESS, ERROR_BASE_NVM);
+        wake_up_count |= ((uint32_t) nvm_byte);
+        AT_reply_add_string((idx == 0) ? "rtc_wake_up_count=" : "exti_wake_up_count=");
+        AT_reply_add_integer((int32_t) wake_up_count, STRING_FORMAT_DECIMAL, 0);
+        AT_send_reply();
+    }
+errors:
+    return status;
+}
+#endif
+
 /*******************************************************************/
 static AT_status_t _CLI_adc_callback(void) {
     // Local variables.
@@ -412,6 +721,112 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static AT_status_t _CLI_acal_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    ANALOG_calibration_t calibration;
+    int32_t channel = 0;
+    int32_t gain_correction = 0;
+    int32_t offset_mv = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &channel);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &gain_correction);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &offset_mv);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check ranges.
+    if ((channel < 0) || (channel > 1) || (gain_correction < INT16_MIN) || (gain_correction > INT16_MAX) || (offset_mv < INT16_MIN) || (offset_mv > INT16_MAX)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    calibration.gain_correction = (int16_t) gain_correction;
+    calibration.offset_mv = (int16_t) offset_mv;
+    // Store calibration.
+    analog_status = ANALOG_set_calibration(((channel == 0) ? ANALOG_CHANNEL_SOURCE_VOLTAGE_MV : ANALOG_CHANNEL_STORAGE_VOLTAGE_MV), &calibration);
+    _CLI_check_driver_status(analog_status, ANALOG_SUCCESS, ERROR_BASE_ANALOG);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_aovs_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    int32_t channel = 0;
+    int32_t oversampling_ratio = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &channel);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &oversampling_ratio);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check ranges.
+    if ((channel < 0) || (channel > 1) || (oversampling_ratio < 0)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    // Set ratio.
+    analog_status = ANALOG_set_oversampling_ratio(((channel == 0) ? ANALOG_CHANNEL_MCU_VOLTAGE_MV : ANALOG_CHANNEL_MCU_TEMPERATURE_DEGREES), (ANALOG_oversampling_ratio_t) oversampling_ratio);
+    _CLI_check_driver_status(analog_status, ANALOG_SUCCESS, ERROR_BASE_ANALOG);
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_aref_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    ANALOG_reference_statistics_t reference_statistics;
+    // Read statistics.
+    analog_status = ANALOG_get_reference_statistics(&reference_statistics);
+    _CLI_check_driver_status(analog_status, ANALOG_SUCCESS, ERROR_BASE_ANALOG);
+    // Print statistics.
+    AT_reply_add_string("refresh=");
+    AT_reply_add_integer((int32_t) (reference_statistics.refresh_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(":hit=");
+    AT_reply_add_integer((int32_t) (reference_statistics.hit_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(":age=");
+    AT_reply_add_integer((int32_t) (reference_statistics.age_seconds), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("s");
+    AT_send_reply();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_set_aref_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    ANALOG_reference_policy_t policy;
+    int32_t maximum_age_seconds = 0;
+    int32_t temperature_delta_degrees = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &maximum_age_seconds);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &temperature_delta_degrees);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check ranges.
+    if ((maximum_age_seconds < 0) || (temperature_delta_degrees < 0)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+    policy.maximum_age_seconds = (uint32_t) maximum_age_seconds;
+    policy.temperature_delta_degrees = temperature_delta_degrees;
+    // Update policy.
+    analog_status = ANALOG_set_reference_policy(&policy);
+    _CLI_check_driver_status(analog_status, ANALOG_SUCCESS, ERROR_BASE_ANALOG);
+errors:
+    return status;
+}
+
 /*******************************************************************/
 static AT_status_t _CLI_iths_callback(void) {
     // Local variables.
@@ -524,6 +939,179 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static void _CLI_stream_stop(void) {
+    // Check state.
+    if (cli_ctx.stream_mask == 0) goto errors;
+    // Release power domains.
+    cli_ctx.stream_mask = 0;
+    POWER_disable(POWER_REQUESTER_ID_CLI_STREAM, POWER_DOMAIN_SENSORS);
+    POWER_disable(POWER_REQUESTER_ID_CLI_STREAM, POWER_DOMAIN_ANALOG);
+errors:
+    return;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_stream_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    int32_t domains_mask = 0;
+    int32_t delay_ms = 0;
+    int32_t binary_format = 0;
+    // First try with 3 parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_HEXADECIMAL, CLI_CHAR_SEPARATOR, &domains_mask);
+    if (parser_status == PARSER_SUCCESS) {
+        // Read delay and format parameters.
+        parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &delay_ms);
+        PARSER_exit_error(AT_ERROR_BASE_PARSER);
+        parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_BOOLEAN, STRING_CHAR_NULL, &binary_format);
+        PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    }
+    else {
+        // Try with 1 parameter.
+        parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_HEXADECIMAL, STRING_CHAR_NULL, &domains_mask);
+        PARSER_exit_error(AT_ERROR_BASE_PARSER);
+        // Only stop request is allowed without delay.
+        if (domains_mask != 0) {
+            status = AT_ERROR_COMMAND_EXECUTION;
+            goto errors;
+        }
+    }
+    // Check parameters.
+    if ((domains_mask < 0) || (domains_mask >= (0b1 << CLI_STREAM_DOMAIN_LAST)) || (delay_ms < 0) || (delay_ms > CLI_STREAM_DELAY_MS_MAX)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto errors;
+    }
+#ifndef HW2_0
+    // External sensor is not available.
+    domains_mask &= ~(0b1 << CLI_STREAM_DOMAIN_SHT30_EXTERNAL);
+#endif
+    // Stop current stream.
+    _CLI_stream_stop();
+    if (domains_mask == 0) goto errors;
+    // Turn required domains on.
+    if ((domains_mask & (0b1 << CLI_STREAM_DOMAIN_ANALOG)) != 0) {
+        POWER_enable(POWER_REQUESTER_ID_CLI_STREAM, POWER_DOMAIN_ANALOG, LPTIM_DELAY_MODE_ACTIVE);
+    }
+    if ((domains_mask & CLI_STREAM_I2C_DOMAINS_MASK) != 0) {
+        POWER_enable(POWER_REQUESTER_ID_CLI_STREAM, POWER_DOMAIN_SENSORS, LPTIM_DELAY_MODE_SLEEP);
+    }
+    // Start stream.
+    cli_ctx.stream_mask = (uint8_t) domains_mask;
+    cli_ctx.stream_delay_ms = (uint32_t) delay_ms;
+    cli_ctx.stream_binary_format = (uint8_t) binary_format;
+    cli_ctx.stream_record_count = 0;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static void _CLI_stream_record(void) {
+    // Local variables.
+    ANALOG_status_t analog_status = ANALOG_SUCCESS;
+    SHT3X_status_t sht3x_status = SHT3X_SUCCESS;
+    DPS310_status_t dps310_status = DPS310_SUCCESS;
+    SI1133_status_t si1133_status = SI1133_SUCCESS;
+    TERMINAL_status_t terminal_status = TERMINAL_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    int32_t values[CLI_STREAM_VALUES_SIZE_MAX];
+    uint8_t values_count = 0;
+    uint8_t binary_record[CLI_STREAM_BINARY_SIZE_MAX];
+    uint8_t binary_record_size = 0;
+    uint16_t crc = 0;
+    uint8_t idx = 0;
+    // Analog channels.
+    if ((cli_ctx.stream_mask & (0b1 << CLI_STREAM_DOMAIN_ANALOG)) != 0) {
+        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SOURCE_VOLTAGE_MV, &(values[values_count]));
+        ANALOG_stack_error(ERROR_BASE_ANALOG);
+        if (analog_status != ANALOG_SUCCESS) values[values_count] = CLI_STREAM_ERROR_VALUE;
+        values_count++;
+        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_STORAGE_VOLTAGE_MV, &(values[values_count]));
+        ANALOG_stack_error(ERROR_BASE_ANALOG);
+        if (analog_status != ANALOG_SUCCESS) values[values_count] = CLI_STREAM_ERROR_VALUE;
+        values_count++;
+        analog_status = ANALOG_convert_channel(ANALOG_CHANNEL_SUNSHINE_LIGHT_PERCENT, &(values[values_count]));
+        ANALOG_stack_error(ERROR_BASE_ANALOG);
+        if (analog_status != ANALOG_SUCCESS) values[values_count] = CLI_STREAM_ERROR_VALUE;
+        values_count++;
+    }
+    // Internal temperature and humidity.
+    if ((cli_ctx.stream_mask & (0b1 << CLI_STREAM_DOMAIN_SHT30_INTERNAL)) != 0) {
+        sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30_INTERNAL, &(values[values_count]), &(values[values_count + 1]));
+        SHT3X_stack_error(ERROR_BASE_SHT30_INTERNAL);
+        if (sht3x_status != SHT3X_SUCCESS) {
+            values[values_count] = CLI_STREAM_ERROR_VALUE;
+            values[values_count + 1] = CLI_STREAM_ERROR_VALUE;
+        }
+        values_count += 2;
+    }
+#ifdef HW2_0
+    // External temperature and humidity.
+    if ((cli_ctx.stream_mask & (0b1 << CLI_STREAM_DOMAIN_SHT30_EXTERNAL)) != 0) {
+        sht3x_status = SHT3X_get_temperature_humidity(I2C_ADDRESS_SHT30_EXTERNAL, &(values[values_count]), &(values[values_count + 1]));
+        SHT3X_stack_error(ERROR_BASE_SHT30_EXTERNAL);
+        if (sht3x_status != SHT3X_SUCCESS) {
+            values[values_count] = CLI_STREAM_ERROR_VALUE;
+            values[values_count + 1] = CLI_STREAM_ERROR_VALUE;
+        }
+        values_count += 2;
+    }
+#endif
+    // Pressure and temperature.
+    if ((cli_ctx.stream_mask & (0b1 << CLI_STREAM_DOMAIN_DPS310)) != 0) {
+        dps310_status = DPS310_get_pressure_temperature(I2C_ADDRESS_DPS310, &(values[values_count]), &(values[values_count + 1]));
+        DPS310_stack_error(ERROR_BASE_DPS310);
+        if (dps310_status != DPS310_SUCCESS) {
+            values[values_count] = CLI_STREAM_ERROR_VALUE;
+            values[values_count + 1] = CLI_STREAM_ERROR_VALUE;
+        }
+        values_count += 2;
+    }
+    // UV index.
+    if ((cli_ctx.stream_mask & (0b1 << CLI_STREAM_DOMAIN_SI1133)) != 0) {
+        si1133_status = SI1133_get_uv_index(I2C_ADDRESS_SI1133, &(values[values_count]));
+        SI1133_stack_error(ERROR_BASE_SI1133);
+        if (si1133_status != SI1133_SUCCESS) values[values_count] = CLI_STREAM_ERROR_VALUE;
+        values_count++;
+    }
+    // Print record.
+    if (cli_ctx.stream_binary_format == 0) {
+        // CSV line starting with record index.
+        AT_reply_add_integer((int32_t) cli_ctx.stream_record_count, STRING_FORMAT_DECIMAL, 0);
+        for (idx = 0; idx < values_count; idx++) {
+            AT_reply_add_string(",");
+            AT_reply_add_integer(values[idx], STRING_FORMAT_DECIMAL, 0);
+        }
+        AT_send_reply();
+    }
+    else {
+        // Header.
+        binary_record[binary_record_size++] = CLI_STREAM_BINARY_SYNC_BYTE;
+        binary_record[binary_record_size++] = (uint8_t) (CLI_STREAM_BINARY_HEADER_SIZE + (4 * values_count) + 2);
+        binary_record[binary_record_size++] = cli_ctx.stream_mask;
+        for (idx = 0; idx < 4; idx++) {
+            binary_record[binary_record_size++] = (uint8_t) (cli_ctx.stream_record_count >> (8 * idx));
+        }
+        // Values in little endian.
+        for (idx = 0; idx < (4 * values_count); idx++) {
+            binary_record[binary_record_size++] = (uint8_t) (((uint32_t) values[idx >> 2]) >> (8 * (idx & 0x03)));
+        }
+        // CRC.
+        crc = _CLI_compute_crc16(binary_record, binary_record_size);
+        binary_record[binary_record_size++] = (uint8_t) (crc >> 8);
+        binary_record[binary_record_size++] = (uint8_t) (crc >> 0);
+        terminal_status = TERMINAL_HW_write(TERMINAL_INSTANCE_CLI, binary_record, binary_record_size);
+        TERMINAL_stack_error(ERROR_BASE_TERMINAL_AT);
+    }
+    cli_ctx.stream_record_count++;
+    // Record delay.
+    if (cli_ctx.stream_delay_ms != 0) {
+        lptim_status = LPTIM_delay_milliseconds(cli_ctx.stream_delay_ms, LPTIM_DELAY_MODE_SLEEP);
+        LPTIM_stack_error(ERROR_BASE_LPTIM);
+    }
+}
+
 /*******************************************************************/
 static AT_status_t _CLI_time_callback(void) {
     // Local variables.
@@ -642,6 +1230,47 @@ errors:
     return status;
 }
 
+/*******************************************************************/
+static AT_status_t _CLI_gpss_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    GPS_status_t gps_status = GPS_SUCCESS;
+    GPS_statistics_t gps_statistics;
+    // Read statistics.
+    gps_status = GPS_get_statistics(&gps_statistics);
+    _CLI_check_driver_status(gps_status, GPS_SUCCESS, ERROR_BASE_GPS);
+    // Acquisitions.
+    AT_reply_add_string("acquisitions=");
+    AT_reply_add_integer((int32_t) (gps_statistics.acquisition_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(":");
+    AT_reply_add_integer((int32_t) (gps_statistics.acquisition_duration_seconds), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("s");
+    AT_send_reply();
+    // Processed frames.
+    AT_reply_add_string("frames=");
+    AT_reply_add_integer((int32_t) (gps_statistics.process_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string("/");
+    AT_reply_add_integer((int32_t) (gps_statistics.process_request_count), STRING_FORMAT_DECIMAL, 0);
+    AT_reply_add_string(":overruns=");
+    AT_reply_add_integer((int32_t) (gps_statistics.process_overrun_count), STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+    // Processing load.
+    AT_reply_add_string("max_frames_per_second=");
+    AT_reply_add_integer((int32_t) (gps_statistics.process_max_frames_per_second), STRING_FORMAT_DECIMAL, 0);
+    AT_send_reply();
+errors:
+    return status;
+}
+
+/*******************************************************************/
+static AT_status_t _CLI_gpsr_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    // Start new statistics period.
+    GPS_reset_statistics();
+    return status;
+}
+
 #ifdef SIGFOX_EP_BIDIRECTIONAL
 /*******************************************************************/
 static void _CLI_print_dl_payload(sfx_u8* dl_payload, sfx_u8 dl_payload_size, sfx_s16 rssi_dbm) {
@@ -1014,6 +1643,119 @@ end:
 }
 #endif
 
+#ifdef SIGFOX_EP_BIDIRECTIONAL
+/*******************************************************************/
+static AT_status_t _CLI_sweep_callback(void) {
+    // Local variables.
+    AT_status_t status = AT_SUCCESS;
+    PARSER_status_t parser_status = PARSER_SUCCESS;
+    RF_API_status_t rf_api_status = RF_API_SUCCESS;
+    SX1232_status_t sx1232_status = SX1232_SUCCESS;
+    RFE_status_t rfe_status = RFE_SUCCESS;
+    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    RF_API_radio_parameters_t radio_params;
+    int32_t start_frequency_hz = 0;
+    int32_t stop_frequency_hz = 0;
+    int32_t step_hz = 0;
+    int32_t dwell_ms = 0;
+    int32_t sweep_count = 0;
+    int32_t frequency_hz = 0;
+    int16_t rssi_dbm = 0;
+    uint8_t line_points = 0;
+    uint32_t point_count = 0;
+    uint32_t point_idx = 0;
+    int32_t sweep_idx = 0;
+    // Read parameters.
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &start_frequency_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &stop_frequency_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &step_hz);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, CLI_CHAR_SEPARATOR, &dwell_ms);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    parser_status = PARSER_get_parameter(cli_ctx.at_parser_ptr, STRING_FORMAT_DECIMAL, STRING_CHAR_NULL, &sweep_count);
+    PARSER_exit_error(AT_ERROR_BASE_PARSER);
+    // Check parameters.
+    if ((start_frequency_hz < CLI_SWEEP_FREQUENCY_MIN_HZ) || (stop_frequency_hz > CLI_SWEEP_FREQUENCY_MAX_HZ) || (stop_frequency_hz < start_frequency_hz) || (step_hz <= 0) || (dwell_ms <= 0) || (dwell_ms > CLI_SWEEP_DWELL_MS_MAX) || (sweep_count <= 0)) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto end;
+    }
+    // Compute number of points and check total duration.
+    point_count = ((uint32_t) ((stop_frequency_hz - start_frequency_hz) / step_hz) + 1);
+    if ((point_count > CLI_SWEEP_POINTS_MAX) || ((uint32_t) sweep_count > (CLI_SWEEP_DURATION_MS_MAX / (point_count * ((uint32_t) dwell_ms))))) {
+        status = AT_ERROR_COMMAND_EXECUTION;
+        goto end;
+    }
+    // Radio configuration.
+    radio_params.rf_mode = RF_API_MODE_RX;
+    radio_params.frequency_hz = (sfx_u32) start_frequency_hz;
+    radio_params.modulation = RF_API_MODULATION_NONE;
+    radio_params.bit_rate_bps = 0;
+    radio_params.tx_power_dbm_eirp = SIGFOX_EP_TX_POWER_DBM_EIRP;
+    radio_params.deviation_hz = 0;
+    // Init radio once, only the synthesizer is retuned during the sweep.
+    rf_api_status = RF_API_wake_up();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    rf_api_status = RF_API_init(&radio_params);
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    // Sweeps loop.
+    for (sweep_idx = 0; sweep_idx < sweep_count; sweep_idx++) {
+        line_points = 0;
+        // Frequency loop.
+        for (point_idx = 0; point_idx < point_count; point_idx++) {
+            frequency_hz = (start_frequency_hz + (int32_t) (point_idx * ((uint32_t) step_hz)));
+            // Retune receiver.
+            sx1232_status = SX1232_set_mode(SX1232_MODE_STANDBY);
+            _CLI_check_driver_status(sx1232_status, SX1232_SUCCESS, ERROR_BASE_SX1232);
+            sx1232_status = SX1232_set_rf_frequency((uint32_t) frequency_hz);
+            _CLI_check_driver_status(sx1232_status, SX1232_SUCCESS, ERROR_BASE_SX1232);
+            sx1232_status = SX1232_start_rx();
+            _CLI_check_driver_status(sx1232_status, SX1232_SUCCESS, ERROR_BASE_SX1232);
+            // Dwell time.
+            lptim_status = LPTIM_delay_milliseconds((uint32_t) dwell_ms, LPTIM_DELAY_MODE_ACTIVE);
+            _CLI_check_driver_status(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM);
+            // Read RSSI.
+            rfe_status = RFE_get_rssi(&rssi_dbm);
+            _CLI_check_driver_status(rfe_status, RFE_SUCCESS, ERROR_BASE_RFE);
+            // Each line starts with the frequency of its first point.
+            if (line_points == 0) {
+                AT_reply_add_integer(frequency_hz, STRING_FORMAT_DECIMAL, 0);
+                AT_reply_add_string(":");
+            }
+            else {
+                AT_reply_add_string(",");
+            }
+            AT_reply_add_integer(rssi_dbm, STRING_FORMAT_DECIMAL, 0);
+            line_points++;
+            // Print line.
+            if (line_points >= CLI_SWEEP_POINTS_PER_LINE) {
+                AT_send_reply();
+                line_points = 0;
+            }
+            IWDG_reload();
+        }
+        // Print last line of the sweep.
+        if (line_points != 0) {
+            AT_send_reply();
+        }
+        AT_reply_add_string("end");
+        AT_send_reply();
+    }
+    // Turn radio off.
+    rf_api_status = RF_API_de_init();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    rf_api_status = RF_API_sleep();
+    _CLI_check_driver_status(rf_api_status, RF_API_SUCCESS, (ERROR_BASE_SIGFOX_EP_LIB + (SIGFOX_ERROR_SOURCE_RF_API * ERROR_BASE_STEP)));
+    goto end;
+errors:
+    RF_API_de_init();
+    RF_API_sleep();
+end:
+    return status;
+}
+#endif
+
 /*** CLI functions ***/
 
 /*******************************************************************/
@@ -1062,15 +1804,26 @@ CLI_status_t CLI_process(void) {
     // Local variables.
     CLI_status_t status = CLI_SUCCESS;
     AT_status_t at_status = AT_SUCCESS;
-    // Check process flag.
-    if (cli_ctx.at_process_flag != 0) {
-        // Clear flag.
-        cli_ctx.at_process_flag = 0;
-        // Process AT driver.
-        at_status = AT_process();
-        AT_exit_error(CLI_ERROR_BASE_AT);
+    // Commands are still processed while streaming.
+    do {
+        // Check process flag.
+        if (cli_ctx.at_process_flag != 0) {
+            // Clear flag.
+            cli_ctx.at_process_flag = 0;
+            // Process AT driver.
+            at_status = AT_process();
+            AT_exit_error(CLI_ERROR_BASE_AT);
+        }
+        // Perform streaming record.
+        if (cli_ctx.stream_mask != 0) {
+            _CLI_stream_record();
+            IWDG_reload();
+        }
     }
+    while (cli_ctx.stream_mask != 0);
 errors:
+    // Stop streaming in case of error.
+    _CLI_stream_stop();
     return status;
 }
 
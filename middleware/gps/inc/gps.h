@@ -55,6 +55,19 @@ typedef NEOM8X_time_t GPS_time_t;
  *******************************************************************/
 typedef NEOM8X_position_t GPS_position_t;
 
+/*!******************************************************************
+ * \struct GPS_statistics_t
+ * \brief GPS receiver processing statistics.
+ *******************************************************************/
+typedef struct {
+    uint32_t acquisition_count;
+    uint32_t acquisition_duration_seconds;
+    uint32_t process_request_count;
+    uint32_t process_count;
+    uint32_t process_overrun_count;
+    uint32_t process_max_frames_per_second;
+} GPS_statistics_t;
+
 /*** GPS functions ***/
 
 /*!******************************************************************
@@ -97,6 +110,24 @@ GPS_status_t GPS_get_time(GPS_time_t* gps_time, uint32_t timeout_seconds, uint32
  *******************************************************************/
 GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint32_t timeout_seconds, uint32_t* acquisition_duration_seconds, GPS_acquisition_status_t* acquisition_status);
 
+/*!******************************************************************
+ * \fn GPS_status_t GPS_get_statistics(GPS_statistics_t* statistics)
+ * \brief Read GPS receiver processing statistics since last reset.
+ * \param[in]   none
+ * \param[out]  statistics: Pointer to the statistics structure.
+ * \retval      Function execution status.
+ *******************************************************************/
+GPS_status_t GPS_get_statistics(GPS_statistics_t* statistics);
+
+/*!******************************************************************
+ * \fn void GPS_reset_statistics(void)
+ * \brief Reset GPS receiver processing statistics.
+ * \param[in]   none
+ * \param[out]  none
+ * \retval      none
+ *******************************************************************/
+void GPS_reset_statistics(void);
+
 /*******************************************************************/
 #define GPS_exit_error(base) { ERROR_check_exit(gps_status, GPS_SUCCESS, base) }
 
@@ -25,19 +25,32 @@
 typedef struct {
     volatile uint8_t process_flag;
     NEOM8X_acquisition_status_t acquisition_status;
+    GPS_statistics_t statistics;
 } GPS_context_t;
 
 /*** GPS local global variables ***/
 
 static GPS_context_t gps_ctx = {
     .process_flag = 0,
-    .acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL
+    .acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL,
+    .statistics.acquisition_count = 0,
+    .statistics.acquisition_duration_seconds = 0,
+    .statistics.process_request_count = 0,
+    .statistics.process_count = 0,
+    .statistics.process_overrun_count = 0,
+    .statistics.process_max_frames_per_second = 0
 };
 
 /*** GPS local functions ***/
 
 /*******************************************************************/
 static void _GPS_process_callback(void) {
+    // Update statistics.
+    gps_ctx.statistics.process_request_count++;
+    // Previous request has not been processed yet.
+    if (gps_ctx.process_flag != 0) {
+        gps_ctx.statistics.process_overrun_count++;
+    }
     // Set local flag.
     gps_ctx.process_flag = 1;
 }
@@ -57,9 +70,12 @@ static GPS_status_t _GPS_perform_acquisition(NEOM8X_gps_data_t gps_data, NEOM8X_
     uint32_t uptime = RTC_get_uptime_seconds();
     uint32_t start_time = uptime;
     uint8_t callback_flag = 0;
+    uint32_t process_frames_per_second = 0;
     // Reset data.
     gps_ctx.acquisition_status = NEOM8X_ACQUISITION_STATUS_FAIL;
     (*acquisition_duration_seconds) = 0;
+    // Update statistics.
+    gps_ctx.statistics.acquisition_count++;
     // Configure GPS acquisition.
     gps_acquisition.gps_data = gps_data;
     gps_acquisition.completion_callback = &_GPS_completion_callback;
@@ -74,6 +90,11 @@ static GPS_status_t _GPS_perform_acquisition(NEOM8X_gps_data_t gps_data, NEOM8X_
             // Update time and reload watchdog.
             uptime = RTC_get_uptime_seconds();
             IWDG_reload();
+            // Update worst case number of frames processed within one second.
+            if (process_frames_per_second > gps_ctx.statistics.process_max_frames_per_second) {
+                gps_ctx.statistics.process_max_frames_per_second = process_frames_per_second;
+            }
+            process_frames_per_second = 0;
         }
         // Enter sleep mode.
         PWR_enter_sleep_mode(PWR_SLEEP_MODE_NORMAL);
@@ -87,6 +108,9 @@ static GPS_status_t _GPS_perform_acquisition(NEOM8X_gps_data_t gps_data, NEOM8X_
             // Process driver.
             neom8x_status = NEOM8X_process();
             NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
+            // Update statistics.
+            gps_ctx.statistics.process_count++;
+            process_frames_per_second++;
         }
         // Check acquisition status.
         if (gps_ctx.acquisition_status == expected_acquisition_status) break;
@@ -101,6 +125,8 @@ static GPS_status_t _GPS_perform_acquisition(NEOM8X_gps_data_t gps_data, NEOM8X_
     NEOM8X_exit_error(GPS_ERROR_BASE_NEOM8N);
 errors:
     NEOM8X_stop_acquisition();
+    // Update statistics.
+    gps_ctx.statistics.acquisition_duration_seconds += (*acquisition_duration_seconds);
     return status;
 }
 
@@ -184,3 +210,29 @@ GPS_status_t GPS_get_position(GPS_position_t* gps_position, uint32_t timeout_sec
 errors:
     return status;
 }
+
+/*******************************************************************/
+GPS_status_t GPS_get_statistics(GPS_statistics_t* statistics) {
+    // Local variables.
+    GPS_status_t status = GPS_SUCCESS;
+    // Check parameter.
+    if (statistics == NULL) {
+        status = GPS_ERROR_NULL_PARAMETER;
+        goto errors;
+    }
+    // Copy statistics.
+    (*statistics) = gps_ctx.statistics;
+errors:
+    return status;
+}
+
+/*******************************************************************/
+void GPS_reset_statistics(void) {
+    // Reset all counters.
+    gps_ctx.statistics.acquisition_count = 0;
+    gps_ctx.statistics.acquisition_duration_seconds = 0;
+    gps_ctx.statistics.process_request_count = 0;
+    gps_ctx.statistics.process_count = 0;
+    gps_ctx.statistics.process_overrun_count = 0;
+    gps_ctx.statistics.process_max_frames_per_second = 0;
+}
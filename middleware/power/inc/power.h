@@ -37,7 +37,7 @@ typedef enum {
     POWER_ERROR_DRIVER_ANALOG,
     POWER_ERROR_DRIVER_DPS310,
     POWER_ERROR_DRIVER_GPS,
-    POWER_ERROR_DRIVER_LPTIM,
+    POWER_ERROR_DRIVER_DELAY_ARBITER,
     POWER_ERROR_DRIVER_RFE,
     POWER_ERROR_DRIVER_SHT3X,
     POWER_ERROR_DRIVER_SI1133,
@@ -57,6 +57,7 @@ typedef enum {
     POWER_REQUESTER_ID_MCU_API,
     POWER_REQUESTER_ID_RF_API,
     POWER_REQUESTER_ID_CLI,
+    POWER_REQUESTER_ID_CLI_STREAM,
     POWER_REQUESTER_ID_LAST
 } POWER_requester_id_t;
 
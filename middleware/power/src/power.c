@@ -8,6 +8,7 @@
 #include "power.h"
 
 #include "analog.h"
+#include "delay_arbiter.h"
 #include "dps310.h"
 #include "error.h"
 #include "error_base.h"
@@ -175,7 +176,7 @@ void POWER_init(void) {
 /*******************************************************************/
 void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTIM_delay_mode_t delay_mode) {
     // Local variables.
-    LPTIM_status_t lptim_status = LPTIM_SUCCESS;
+    DELAY_ARBITER_status_t delay_arbiter_status = DELAY_ARBITER_SUCCESS;
     uint32_t delay_ms = 0;
     uint8_t action_required = 0;
     // Check parameters.
@@ -261,8 +262,8 @@ void POWER_enable(POWER_requester_id_t requester_id, POWER_domain_t domain, LPTI
     }
     // Power on delay.
     if (delay_ms != 0) {
-        lptim_status = LPTIM_delay_milliseconds(delay_ms, delay_mode);
-        _POWER_stack_driver_error(lptim_status, LPTIM_SUCCESS, ERROR_BASE_LPTIM, POWER_ERROR_DRIVER_LPTIM);
+        delay_arbiter_status = DELAY_ARBITER_milliseconds(delay_ms, delay_mode);
+        _POWER_stack_driver_error(delay_arbiter_status, DELAY_ARBITER_SUCCESS, ERROR_BASE_DELAY_ARBITER, POWER_ERROR_DRIVER_DELAY_ARBITER);
     }
 errors:
     return;
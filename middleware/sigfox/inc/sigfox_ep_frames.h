@@ -17,6 +17,7 @@
 
 // Uplink payload sizes.
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_STARTUP           8
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_CRASH             4
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK       12
 #ifdef SPSWS_WIND_RAINFALL_MEASUREMENTS
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_WEATHER           10
@@ -24,8 +25,39 @@
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_WEATHER           6
 #endif
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING        9
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING_EVENT  7
+#ifdef SPSWS_PROFILING
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING         5
+#endif
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC            11
 #define SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC_TIMEOUT    2
+// Uplink frames are identified by their size on the backend side: each size must be unique.
+#ifdef SPSWS_PROFILING
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_PROFILING    (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING)
+#else
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_PROFILING    0
+#endif
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_SUM          ((0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_STARTUP) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_CRASH) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_WEATHER) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING_EVENT) + \
+                                                     SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_PROFILING + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC) + \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC_TIMEOUT))
+#define SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_OR           ((0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_STARTUP) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_CRASH) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_ERROR_STACK) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_WEATHER) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING_EVENT) | \
+                                                     SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_PROFILING | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC) | \
+                                                     (0b1UL << SIGFOX_EP_UL_PAYLOAD_SIZE_GEOLOC_TIMEOUT))
+#if (SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_SUM != SIGFOX_EP_UL_PAYLOAD_SIZE_MASK_OR)
+#error "SIGFOX EP frames: uplink payload sizes must be unique"
+#endif
 // Error values.
 #define SIGFOX_EP_ERROR_VALUE_TEMPERATURE           0x7FF
 #define SIGFOX_EP_ERROR_VALUE_HUMIDITY              0xFF
@@ -38,6 +70,8 @@
 #define SIGFOX_EP_ERROR_VALUE_STORAGE_VOLTAGE       0xFFF
 #define SIGFOX_EP_ERROR_VALUE_MCU_TEMPERATURE       0x7F
 #define SIGFOX_EP_ERROR_VALUE_MCU_VOLTAGE           0xFFF
+#define SIGFOX_EP_ERROR_VALUE_WIND_CONFIDENCE       0xFF
+#define SIGFOX_EP_ERROR_VALUE_RAINFALL_INTENSITY    0xFFF
 // Rainfall unit threshold.
 #define SIGFOX_EP_RAINFALL_MAX_UM                   126000
 #define SIGFOX_EP_RAINFALL_UNIT_THRESHOLD_UM        12700
@@ -60,6 +94,20 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SIGFOX_EP_ul_payload_startup_t;
 
+/*!******************************************************************
+ * \struct SIGFOX_EP_ul_payload_crash_t
+ * \brief Sigfox uplink crash frame format.
+ *******************************************************************/
+typedef union {
+    uint8_t frame[SIGFOX_EP_UL_PAYLOAD_SIZE_CRASH];
+    struct {
+        unsigned state :4;
+        unsigned hard_fault_flag :1;
+        unsigned pc_offset :19;
+        unsigned uptime_hours :8;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} SIGFOX_EP_ul_payload_crash_t;
+
 /*******************************************************************/
 typedef enum {
     SIGFOX_EP_UL_PAYLOAD_RAINFALL_UNIT_TENTH_MM = 0b0,
@@ -110,6 +158,39 @@ typedef union {
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SIGFOX_EP_ul_payload_monitoring_t;
 
+/*!******************************************************************
+ * \struct SIGFOX_EP_ul_payload_monitoring_event_t
+ * \brief Sigfox uplink monitoring event frame format.
+ *******************************************************************/
+typedef union {
+    uint8_t frame[SIGFOX_EP_UL_PAYLOAD_SIZE_MONITORING_EVENT];
+    struct {
+        unsigned sensors_status :8;
+        unsigned wind_direction_confidence_percent :8;
+        unsigned rainfall_peak_1_minute_tenth_mm_per_hour :12;
+        unsigned rainfall_peak_5_minutes_tenth_mm_per_hour :12;
+        unsigned rainfall_peak_10_minutes_tenth_mm_per_hour :12;
+        unsigned stack_free :4;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} SIGFOX_EP_ul_payload_monitoring_event_t;
+
+#ifdef SPSWS_PROFILING
+/*!******************************************************************
+ * \struct SIGFOX_EP_ul_payload_profiling_t
+ * \brief Sigfox uplink profiling frame format.
+ *******************************************************************/
+typedef union {
+    uint8_t frame[SIGFOX_EP_UL_PAYLOAD_SIZE_PROFILING];
+    struct {
+        unsigned awake_seconds :12;
+        unsigned dominant_state :4;
+        unsigned dominant_state_seconds :12;
+        unsigned dominant_state_max_seconds :8;
+        unsigned filtered_wake_up_count_log2 :4;
+    } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
+} SIGFOX_EP_ul_payload_profiling_t;
+#endif
+
 /*!******************************************************************
  * \struct SIGFOX_EP_ul_payload_geoloc_t
  * \brief Sigfox uplink geolocation frame format.
@@ -152,6 +233,7 @@ typedef enum {
     SIGFOX_EP_DL_OP_CODE_RESET,
     SIGFOX_EP_DL_OP_CODE_SET_WEATHER_DATA_PERIOD,
     SIGFOX_EP_DL_OP_CODE_SET_DATE_TIME,
+    SIGFOX_EP_DL_OP_CODE_SET_SENSORS_PRECISION,
     SIGFOX_EP_DL_OP_CODE_LAST
 } SIGFOX_EP_dl_op_code_t;
 #endif
@@ -196,6 +278,13 @@ typedef union {
                 unsigned minutes :8;
                 unsigned seconds :8;
             } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) set_date_time;
+            struct {
+                unsigned sht3x_precision :8;
+                unsigned dps310_precision :8;
+                unsigned si1133_precision :8;
+                unsigned unused0 :16;
+                unsigned unused1 :16;
+            } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed)) set_sensors_precision;
         };
     } __attribute__((scalar_storage_order("big-endian"))) __attribute__((packed));
 } SIGFOX_EP_dl_payload_t;